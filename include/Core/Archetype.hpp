@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "SlotMap.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Entities that have exactly the same components, stored as one dense
+// column per component, so a system only streams the columns it reads.
+// Row i of every column belongs to the same entity; erasing swaps the last
+// row into the hole.
+template <typename... Components> class Archetype {
+public:
+    using Handle = SlotIndex::Handle;
+
+    Handle create(Components... values) {
+        (column<Components>().push_back(std::move(values)), ...);
+        return index.insert();
+    }
+
+    // Creates an entity from a superset of its components, moving the ones
+    // it has and ignoring the rest
+    template <typename... Given> Handle createFrom(Given &...given) {
+        std::tuple<Given &...> all(given...);
+        return create(std::move(std::get<Components &>(all))...);
+    }
+
+    template <typename C> std::vector<C> &column() {
+        return std::get<std::vector<C>>(columns);
+    }
+    template <typename C> const std::vector<C> &column() const {
+        return std::get<std::vector<C>>(columns);
+    }
+
+    template <typename C> static constexpr bool has() {
+        return (std::is_same_v<C, Components> || ...);
+    }
+
+    bool contains(Handle handle) const { return index.contains(handle); }
+    // Only meaningful when contains(handle)
+    size_t indexOf(Handle handle) const { return index.indexOf(handle); }
+    Handle handleAt(size_t row) const { return index.handleAt(row); }
+
+    // The last row moves into row, so during a walk it has to be visited
+    // again
+    void eraseAt(size_t row) {
+        (eraseRow(column<Components>(), row), ...);
+        index.eraseAt(row);
+    }
+
+    void clear() {
+        while (size() > 0ul)
+            eraseAt(size() - 1);
+    }
+
+    void reserve(size_t capacity) {
+        (column<Components>().reserve(capacity), ...);
+        index.reserve(capacity);
+    }
+
+    size_t size() const { return index.size(); }
+
+private:
+    template <typename C> static void eraseRow(std::vector<C> &c, size_t row) {
+        if (row + 1 != c.size())
+            c[row] = std::move(c.back());
+        c.pop_back();
+    }
+
+    std::tuple<std::vector<Components>...> columns;
+    SlotIndex index;
+};
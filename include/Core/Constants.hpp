@@ -27,10 +27,27 @@ constexpr const char *GAME_FONT = "assets/Morning Routine.otf";
 constexpr const char *PARAGRAPH_FONT = "assets/NotoSans-MediumItalic.ttf";
 constexpr float LOGO_DURATION = 3.0f;
 
+// Texture Properties
+constexpr const char *ASSETS_DIRECTORY  = "assets";
+constexpr unsigned ATLAS_PAGE_SIZE      = 2048;
+constexpr unsigned ATLAS_MAX_IMAGE_SIZE = 512; // larger images stay alone
+// Scaled down, so they are smoothed; a page is smoothed as a whole, so
+// these stay out of the atlas
+constexpr const char *SMOOTH_TEXTURES[] = {"assets/me1.png",
+                                           "assets/me2.png"};
+
 // Screen Properties
 constexpr int SCREEN_WIDTH  = 1440;
 constexpr int SCREEN_HEIGHT = 900;
 
+// Simulation Properties
+constexpr float SIMULATION_TICK_RATE = 120.0f;
+constexpr float SIMULATION_TICK      = 1.0f / SIMULATION_TICK_RATE;
+constexpr float MAX_FRAME_TIME       = 0.25f;
+
+// Collision Properties
+constexpr float COLLISION_CELL_SIZE = 96.0f;
+
 // Player Properties
 constexpr size_t PLAYER_BULLET_ID        = 1ul;
 constexpr size_t PLAYER_SUPER_BULLET_ID  = 4ul;
@@ -54,11 +71,20 @@ constexpr int ENEMY2_MAX_ALIVE           = 32;
 constexpr float ENEMY3_SPAWN_PROB        = 0.02f;
 constexpr int ENEMY3_MAX_ALIVE           = 1;
 constexpr size_t ENEMY_LEVEL_COUNT       = 3;
+constexpr size_t ENEMY_SPAWN_BUDGET      = 8; // queued spawns per tick
+constexpr size_t ENEMY_CHUNK_SIZE        = 16; // rows per parallel task
 
 // Bullet Properties
+constexpr size_t BULLET_CAPACITY           = 8192;
+constexpr size_t BULLET_OBJECT_CAPACITY    = 256;
+constexpr float BULLET_HOSTILE_SHARE       = 0.75f;
 constexpr float ROCKET_DAMAGE_RATE_INITIAL = 0.84f;
 constexpr float ROCKET_DAMAGE_RATE         = 0.184f;
 
+// Effect Properties
+constexpr size_t EFFECT_CAPACITY   = 256;  // blasts and animations each
+constexpr size_t PARTICLE_CAPACITY = 4096;
+
 // Gift Properties
 constexpr float GIFT_SPAWN_PROBABILITY = 0.36f;
 constexpr float GIFT_SPAWN_INTERVAL    = 32.0f;
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Instruction sets that hot kernels are built for, in increasing order
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+// Runtime dispatch of the SIMD kernels.
+//
+// Every kernel is compiled for each SimdLevel regardless of the compiler
+// flags, so a binary built for the x86-64 baseline still runs the AVX2
+// versions where the CPU has them. init() detects the CPU once and binds
+// the kernels; until then they point at the scalar versions.
+class CpuDispatch {
+public:
+    CpuDispatch() = delete;
+
+    // Bind the kernels for the best level the CPU supports, or the scalar
+    // ones if forceScalar, and log the choice
+    static void init(bool forceScalar = false);
+    // The best level the CPU supports
+    static SimdLevel detect();
+    static SimdLevel getLevel() { return level; }
+    static const char *getName(SimdLevel level);
+
+    // Kernels
+
+    // x += vx * dt, y += vy * dt for slots [0, count), keeping the old
+    // position for render interpolation, and append the slots that left
+    // the arena to culled in increasing order
+    using IntegrateFn = void (*)(float *x, float *y, float *prevX,
+                                 float *prevY, const float *vx,
+                                 const float *vy, std::vector<uint32_t> &culled,
+                                 size_t count, float dt);
+    // Bit i set when box i intersects area, for at most 64 boxes given by
+    // their edges. Touching edges do not count, as in sf::Rect::intersects.
+    using OverlapFn = uint64_t (*)(const float *left, const float *top,
+                                   const float *right, const float *bottom,
+                                   size_t count, const sf::FloatRect &area);
+    // Two triangles (six vertices from out) for each of count quads of
+    // halfSize centred on (x[i], y[i]), all showing texRect in color
+    using FillQuadsFn = void (*)(const float *x, const float *y, size_t count,
+                                 sf::Vector2f halfSize,
+                                 const sf::FloatRect &texRect, sf::Color color,
+                                 sf::Vertex *out);
+
+    static IntegrateFn integrate;
+    static OverlapFn overlap;
+    static FillQuadsFn fillQuads;
+
+private:
+    static SimdLevel level;
+};
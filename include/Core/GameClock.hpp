@@ -0,0 +1,31 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Monotonic simulation time in seconds. Game advances it once per tick and
+// every Timer measures against it, so a paused game freezes all timers and
+// reading a timer is plain arithmetic instead of a system clock query.
+class GameClock {
+public:
+    GameClock() = delete;
+
+    static double now() { return current; }
+    static void advance(float seconds) { current += seconds; }
+
+private:
+    static double current;
+};
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool.
+//
+// Every worker has its own queue and takes its newest job first. An idle
+// worker steals the oldest job from another queue, and jobs submitted from
+// outside the pool go to a queue of their own that everyone steals from.
+// A thread waiting on a Group runs queued jobs instead of blocking, so
+// jobs may submit and wait on further jobs.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // Counts the unfinished jobs submitted with it
+    class Group {
+    public:
+        bool isDone() const {
+            return pending.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+        std::atomic<size_t> pending{0};
+    };
+
+    // Threads besides the caller's; 0 runs every job on the waiting thread
+    explicit JobSystem(size_t workers = defaultWorkerCount());
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // Logical CPUs this process may run on
+    static size_t availableCpus();
+    // One worker per available CPU but the caller's, up to the limit
+    static size_t defaultWorkerCount();
+    static void setWorkerLimit(size_t limit);
+    size_t getWorkerCount() const { return threads.size(); }
+
+    void submit(Group &group, Job job);
+    // Runs queued jobs until every job of group has finished
+    void wait(Group &group);
+
+    static size_t chunkCount(size_t count, size_t grain) {
+        return (count + grain - 1) / grain;
+    }
+    // Calls f(chunk, begin, end) for every chunk of up to grain items of
+    // [0, count) and returns once all are done. Chunk c always covers the
+    // same items, so results written per chunk can be merged in chunk order
+    // to get the same outcome as a serial loop.
+    template <typename F> void parallelFor(size_t count, size_t grain, F &&f);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // The queue of the calling thread; the shared one for outsiders
+    size_t queueOfThisThread() const;
+    bool tryRunOne(size_t home);
+    void workerLoop(size_t home);
+
+    static size_t workerLimit;
+
+    // queues[0] takes jobs from outside, queues[i] belongs to worker i - 1
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> queued{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleeping;
+    bool stopping = false;
+};
+
+template <typename F>
+void JobSystem::parallelFor(size_t count, size_t grain, F &&f) {
+    grain = std::max<size_t>(grain, 1ul);
+    const size_t chunks = chunkCount(count, grain);
+    if (threads.empty() || chunks <= 1) {
+        for (size_t c = 0; c < chunks; c++)
+            f(c, c * grain, std::min(count, (c + 1) * grain));
+        return;
+    }
+
+    // A few jobs claim chunks until none are left, rather than one job per
+    // chunk
+    std::atomic<size_t> next{0};
+    auto claim = [&] {
+        for (;;) {
+            const size_t c = next.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunks)
+                return;
+            f(c, c * grain, std::min(count, (c + 1) * grain));
+        }
+    };
+    Group group;
+    const size_t helpers = std::min(threads.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; i++)
+        submit(group, [&claim] { claim(); });
+    claim();
+    wait(group);
+}
@@ -16,7 +16,31 @@
 
 #pragma once
 #include <SFML/System/Vector2.hpp>
+#include <bit>
 #include <cmath>
+#include <cstdint>
+
+// A plain pair of floats. Arrays of Vec2 are interleaved x, y lanes with no
+// padding, so a 128-bit register holds two of them.
+struct alignas(8) Vec2 {
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr Vec2() = default;
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+    Vec2(const sf::Vector2f &v) : x(v.x), y(v.y) {}
+    operator sf::Vector2f() const { return {x, y}; }
+
+    constexpr Vec2 operator+(Vec2 o) const { return {x + o.x, y + o.y}; }
+    constexpr Vec2 operator-(Vec2 o) const { return {x - o.x, y - o.y}; }
+    constexpr Vec2 operator*(float s) const { return {x * s, y * s}; }
+    constexpr float dot(Vec2 o) const { return x * o.x + y * o.y; }
+    // z of the 3D cross product: positive when o is less than PI ahead of
+    // this in the direction of increasing atan2 angles
+    constexpr float cross(Vec2 o) const { return x * o.y - y * o.x; }
+    constexpr float lengthSquared() const { return dot(*this); }
+};
+static_assert(sizeof(Vec2) == 2 * sizeof(float));
 
 class Math {
 public:
@@ -90,4 +114,91 @@ public:
     static float vectorToAngle(const sf::Vector2f &v) {
         return std::atan2(v.y, v.x);
     }
+
+    // Fast approximations. They use only float arithmetic and the build
+    // turns off fused multiply-add contraction, so they give the same bits
+    // on every platform, which keeps seeded runs repeatable. `--bench math`
+    // fails if an error exceeds its bound.
+    static constexpr double RSQRT_MAX_ERROR = 5e-6;  // relative
+    static constexpr double ATAN2_MAX_ERROR = 1e-5;  // radians
+    static constexpr double SINCOS_MAX_ERROR = 1e-6; // for |angle| <= 1000
+
+    // 1 / sqrt(x) for x > 0, relative error below 5e-6
+    static float rsqrt(float x) {
+        float y = std::bit_cast<float>(0x5f375a86u -
+                                       (std::bit_cast<uint32_t>(x) >> 1));
+        y *= 1.5f - 0.5f * x * y * y;
+        y *= 1.5f - 0.5f * x * y * y;
+        return y;
+    }
+
+    // v scaled to length 1 using rsqrt(); zero stays zero
+    static Vec2 fastNormalize(Vec2 v) {
+        const float lengthSquared = v.lengthSquared();
+        return lengthSquared > 0.0f ? v * rsqrt(lengthSquared) : v;
+    }
+
+    // atan2(y, x), absolute error below 1e-5 radians; 0 for (0, 0)
+    static float fastAtan2(float y, float x) {
+        const float ax = std::abs(x), ay = std::abs(y);
+        const float hi = ax > ay ? ax : ay;
+        if (hi == 0.0f)
+            return 0.0f;
+        const float lo = ax > ay ? ay : ax;
+        // Odd minimax polynomial for atan on [0, 1]
+        const float z = lo / hi, z2 = z * z;
+        float angle =
+            z * (0.99997726f +
+                 z2 * (-0.33262347f +
+                       z2 * (0.19354346f +
+                             z2 * (-0.11643287f +
+                                   z2 * (0.05265332f + z2 * -0.01172120f)))));
+        if (ay > ax)
+            angle = PI / 2.0f - angle;
+        if (x < 0.0f)
+            angle = PI - angle;
+        return y < 0.0f ? -angle : angle;
+    }
+
+    // sin and cos of angle, absolute error below 1e-6 for |angle| <= 1000
+    static void fastSinCos(float angle, float &sine, float &cosine) {
+        // Reduce to [-PI/4, PI/4] around the nearest multiple of PI/2, with
+        // PI/2 split in two so the reduction itself stays exact
+        const float quarter = std::nearbyint(angle * (2.0f / PI));
+        const float r =
+            (angle - quarter * 1.5703125f) - quarter * 4.8382679e-4f;
+        const float r2 = r * r;
+        const float s =
+            r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f +
+                                               r2 * (-1.0f / 5040.0f)));
+        const float c =
+            1.0f + r2 * (-0.5f + r2 * (1.0f / 24.0f +
+                                       r2 * (-1.0f / 720.0f +
+                                             r2 * (1.0f / 40320.0f))));
+        switch ((int64_t)quarter & 3) {
+            case 0: sine = s; cosine = c; break;
+            case 1: sine = c; cosine = -s; break;
+            case 2: sine = -s; cosine = -c; break;
+            default: sine = -c; cosine = s; break;
+        }
+    }
+
+    // The unit vector direction turned towards the unit vector target by at
+    // most maxTurn radians, without converting either to an angle. A target
+    // straight behind is approached through increasing angles.
+    static Vec2 steer(Vec2 direction, Vec2 target, float maxTurn) {
+        if (maxTurn >= PI)
+            return target;
+        float sine, cosine;
+        fastSinCos(maxTurn, sine, cosine);
+        // Within reach when the angle between them is at most maxTurn
+        if (direction.dot(target) >= cosine)
+            return target;
+        if (direction.cross(target) < 0.0f)
+            sine = -sine;
+        // Rotated and brought back to unit length, so the error of
+        // fastSinCos() does not build up from tick to tick
+        return fastNormalize({direction.x * cosine - direction.y * sine,
+                              direction.x * sine + direction.y * cosine});
+    }
 };
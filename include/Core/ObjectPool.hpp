@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed number of preallocated slots, each large enough for any of Types.
+// create() constructs an object in a free slot and returns a unique_ptr
+// whose deleter destroys it and puts the slot back, both in O(1).
+template <typename Base, typename... Types> class ObjectPool {
+    static_assert((std::is_base_of_v<Base, Types> && ...));
+    static_assert(std::has_virtual_destructor_v<Base>);
+
+public:
+    class Deleter {
+    public:
+        Deleter() = default;
+        explicit Deleter(ObjectPool *pool) : pool(pool) {}
+        void operator()(Base *object) const { pool->destroy(object); }
+
+    private:
+        ObjectPool *pool = nullptr;
+    };
+    template <typename T> using PointerTo = std::unique_ptr<T, Deleter>;
+    using Pointer = PointerTo<Base>;
+
+    explicit ObjectPool(size_t capacity)
+        : capacity(capacity), slots(std::make_unique<Slot[]>(capacity)) {
+        freeSlots.reserve(capacity);
+        for (size_t i = capacity; i > 0; i--)
+            freeSlots.push_back((uint32_t)(i - 1));
+    }
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    // Returns null when every slot is taken
+    template <typename T, typename... Args>
+    PointerTo<T> create(Args &&...args) {
+        static_assert((std::is_same_v<T, Types> || ...));
+        if (freeSlots.empty())
+            return PointerTo<T>(nullptr, Deleter(this));
+
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        try {
+            T *object = new (slots[slot].data) T(std::forward<Args>(args)...);
+            return PointerTo<T>(object, Deleter(this));
+        } catch (...) {
+            freeSlots.push_back(slot);
+            throw;
+        }
+    }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getLiveCount() const { return capacity - freeSlots.size(); }
+
+private:
+    struct alignas(Types...) Slot {
+        std::byte data[std::max({sizeof(Types)...})];
+    };
+
+    void destroy(Base *object) {
+        // The most derived object starts at the beginning of its slot
+        Slot *slot = static_cast<Slot *>(dynamic_cast<void *>(object));
+        object->~Base();
+        freeSlots.push_back((uint32_t)(slot - slots.get()));
+    }
+
+    size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+    std::vector<uint32_t> freeSlots;
+};
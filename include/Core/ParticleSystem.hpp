@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "RandomUtils.hpp"
+#include "SpriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A burst of sparks thrown in random directions, see ParticleSystem::emit()
+struct ParticleBurst {
+    size_t count;
+    float minSpeed, maxSpeed;       // pixels per second
+    float minLifetime, maxLifetime; // seconds
+    float size;                     // of the square, in pixels
+    sf::Color color;
+};
+
+// Untextured sparks stored as structure of arrays in a pool of fixed
+// capacity. Particles drift, slow down under drag and fade out over their
+// lifetime. A burst into a full pool drops the particles that do not fit.
+//
+// Purely visual: the directions come from a random stream of their own, so
+// emitting never changes the simulation.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(size_t capacity);
+
+    // Throw burst.count particles from position, on top of velocity
+    void emit(const ParticleBurst &burst, sf::Vector2f position,
+              sf::Vector2f velocity = {});
+    // Age and move every particle, releasing the expired ones
+    void update(float deltaTime);
+    // Queue the live particles on batch
+    void render(SpriteBatch &batch) const;
+    void clear() { count = 0ul; }
+
+    size_t size() const { return count; }
+    // Particles dropped because the pool was full
+    uint64_t getDroppedCount() const { return dropped; }
+
+private:
+    // The last particle moves into i
+    void eraseAt(size_t i);
+
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> age, lifetime, sizes;
+    std::vector<sf::Color> color;
+    size_t count = 0ul; // live particles are [0, count)
+    uint64_t dropped = 0ul;
+    RandomStream random{RandomStreamId::Effects};
+};
@@ -1,89 +1,195 @@
-#include <ctime>
-#include <numeric>
-#include <random>
+#pragma once
+#include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
 
+// What a RandomStream is drawn for. Each subsystem numbers its own streams,
+// e.g. one per enemy, so no two parts of the game share a sequence.
+enum class RandomStreamId : uint32_t {
+    EnemySpawns = 1, // which enemies appear and where
+    Enemies,         // one stream per spawned enemy: stats, then its guns
+    Player,
+    Gifts,
+    Effects, // visual only, never read by the simulation
+};
+
+// A reproducible sequence of random numbers: the Philox4x32-10 cipher of
+// (draw index, entity, subsystem) under the seed of the run. A stream only
+// holds its own counter, so any thread may draw from its streams without
+// locking, and the same seed replays the same numbers.
+class RandomStream {
+public:
+    using result_type = uint32_t;
+
+    RandomStream() = default;
+    RandomStream(RandomStreamId subsystem, uint32_t entity = 0);
+
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        if (used == block.size()) {
+            block = philox({(uint32_t)index, (uint32_t)(index >> 32),
+                            entity, subsystem});
+            index++;
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    // The Philox4x32-10 block of counter under the stream's key
+    std::array<uint32_t, 4> philox(std::array<uint32_t, 4> counter) const;
+
+private:
+    uint32_t key[2] = {0u, 0u};
+    uint32_t entity = 0u;
+    uint32_t subsystem = 0u;
+    uint64_t index = 0ul; // of the next block
+    std::array<uint32_t, 4> block{};
+    size_t used = 4ul; // numbers of block already handed out
+};
+
+// A choice among N outcomes with fixed relative weights, drawn in O(1) by
+// Vose's alias method: outcome i is kept with probability keep[i] and
+// otherwise replaced by alias[i]. Nothing is allocated, so tables can be
+// built at compile time and copied freely.
+template <size_t N> class AliasTable {
+public:
+    static_assert(N > 0, "AliasTable needs at least one outcome");
+
+    constexpr explicit AliasTable(const std::array<float, N> &weights)
+        : weights(weights) {
+        build();
+    }
+
+    constexpr float getWeight(size_t i) const { return weights[i]; }
+    // O(N); setting a weight to 0 rules the outcome out
+    constexpr void setWeight(size_t i, float weight) {
+        weights[i] = weight;
+        build();
+    }
+
+    // An index in [0, N) drawn with probability proportional to its weight
+    size_t sample(RandomStream &random) const;
+
+private:
+    constexpr void build() {
+        double total = 0.0;
+        for (float weight : weights) {
+            if (weight < 0.0f)
+                throw std::invalid_argument("Weights cannot be negative");
+            total += weight;
+        }
+        if (total <= 0.0)
+            throw std::invalid_argument("Sum of weights must be positive");
+
+        // Scaled so that the mean is 1, then each outcome below 1 is
+        // topped up from one above 1
+        std::array<double, N> scaled{};
+        std::array<size_t, N> small{}, large{};
+        size_t smallCount = 0, largeCount = 0;
+        for (size_t i = 0; i < N; i++) {
+            scaled[i] = weights[i] * (double)N / total;
+            if (scaled[i] < 1.0)
+                small[smallCount++] = i;
+            else
+                large[largeCount++] = i;
+        }
+        while (smallCount > 0 && largeCount > 0) {
+            const size_t less = small[--smallCount];
+            const size_t more = large[--largeCount];
+            keep[less] = (float)scaled[less];
+            alias[less] = more;
+            scaled[more] -= 1.0 - scaled[less];
+            if (scaled[more] < 1.0)
+                small[smallCount++] = more;
+            else
+                large[largeCount++] = more;
+        }
+        // What is left is 1 up to rounding
+        while (largeCount > 0) {
+            const size_t i = large[--largeCount];
+            keep[i] = 1.0f;
+            alias[i] = i;
+        }
+        while (smallCount > 0) {
+            const size_t i = small[--smallCount];
+            keep[i] = weights[i] > 0.0f ? 1.0f : 0.0f;
+            alias[i] = weights[i] > 0.0f ? i : heaviest();
+        }
+    }
+
+    constexpr size_t heaviest() const {
+        size_t best = 0;
+        for (size_t i = 1; i < N; i++)
+            if (weights[i] > weights[best])
+                best = i;
+        return best;
+    }
+
+    std::array<float, N> weights;
+    std::array<float, N> keep{};
+    std::array<size_t, N> alias{};
+};
+
 class RandomUtils {
 private:
     RandomUtils() = delete;
     ~RandomUtils() = delete;
 
-    static std::random_device rd;
-    static std::mt19937 gen;
+    static uint64_t seed;
+    static bool seedFixed;
 
 public:
-    // Generate a number in a range
-    template <typename T> static T generateInRange(T min, T max) {
+    // Streams created afterwards use value, for every game of the process
+    static void setSeed(uint64_t value);
+    // Streams created afterwards use a new random seed, unless setSeed()
+    // fixed it
+    static void reseed();
+    static uint64_t getSeed() { return seed; }
+
+    // Generate a number in a range: [min, max] for integers, [min, max)
+    // otherwise
+    template <typename T>
+    static T generateInRange(RandomStream &random, T min, T max) {
         static_assert(std::is_arithmetic<T>::value,
                       "T must be a number type (int, float, etc.)");
 
         if constexpr (std::is_integral<T>::value) {
-            std::uniform_int_distribution<T> dist(min, max);
-            return dist(gen);
+            const uint64_t span = (uint64_t)max - (uint64_t)min + 1ul;
+            return (T)(min + (T)(((uint64_t)random() * span) >> 32));
         } else if constexpr (std::is_floating_point<T>::value) {
-            std::uniform_real_distribution<T> dist(min, max);
-            return dist(gen);
+            return min + (max - min) * (T)unit(random);
         }
     }
 
     // Generate a number from a set
-    template <typename T> static T generateFromSet(const std::vector<T> &set) {
+    template <typename T>
+    static T generateFromSet(RandomStream &random, const std::vector<T> &set) {
         if (set.empty())
             throw std::invalid_argument("Set cannot be empty");
 
-        std::uniform_int_distribution<size_t> dist(0, set.size() - 1);
-        return set[dist(gen)];
+        return set[generateInRange<size_t>(random, 0, set.size() - 1)];
     }
 
-    // Generate a number with given probabilities
-    template <typename T>
-    static T generateFromSetWithProb(const std::vector<T> &set,
-                                     const std::vector<float> &probabilities) {
-        if (set.size() != probabilities.size() || set.empty())
-            throw std::invalid_argument("Set and probabilities must have the "
-                                        "same size and cannot be empty");
-
-        std::vector<float> cumulative_probs(probabilities.size());
-        cumulative_probs[0] = probabilities[0];
-        for (size_t i = 1; i < probabilities.size(); i++)
-            cumulative_probs[i] = cumulative_probs[i - 1] + probabilities[i];
-
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-        float rand_val = dist(gen);
-
-        auto it = std::lower_bound(cumulative_probs.begin(),
-                                   cumulative_probs.end(), rand_val);
-        size_t index = std::distance(cumulative_probs.begin(), it);
-        return set[std::min(set.size() - 1, index)];
-    }
-
-    template <typename T>
-    static T generateFromSetWithRatio(const std::vector<T> &set,
-                                      const std::vector<float> &ratios) {
-        if (set.size() != ratios.size() || set.empty())
-            throw std::invalid_argument(
-                "Set and ratios must have the same size and cannot be empty");
-
-        float total = std::accumulate(ratios.begin(), ratios.end(), 0.0f);
-        if (total <= 0.0f)
-            throw std::invalid_argument("Sum of ratios must be positive");
-
-        std::vector<float> probabilities;
-        probabilities.reserve(ratios.size());
-        for (auto r : ratios)
-            probabilities.push_back(r / total);
-
-        return generateFromSetWithProb(set, probabilities);
-    }
-
-    static bool chooseWithProb(float probability) {
+    static bool chooseWithProb(RandomStream &random, float probability) {
         if (probability < 0.0f || probability > 1.0f)
             throw std::invalid_argument(
                 "Probability must be between 0.0 and 1.0");
 
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-        return dist(gen) < probability;
+        return unit(random) < probability;
+    }
+
+    // Uniform in [0, 1), from the top 24 bits so that every value is exact
+    static float unit(RandomStream &random) {
+        return (float)(random() >> 8) * 0x1p-24f;
     }
 };
+
+template <size_t N>
+size_t AliasTable<N>::sample(RandomStream &random) const {
+    const size_t i = RandomUtils::generateInRange<size_t>(random, 0, N - 1);
+    return RandomUtils::unit(random) < keep[i] ? i : alias[i];
+}
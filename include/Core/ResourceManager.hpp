@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include "TextureAtlas.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <memory>
@@ -44,14 +45,34 @@ class ResourceManager {
 public:
     ResourceManager() = delete;
 
+    // Where an image is drawn from: an atlas page and the rect of the image
+    // on it, or a texture of its own and its full rect. Headless, there is
+    // no texture and the rect only gives the size.
+    struct TextureRegion {
+        const sf::Texture *texture;
+        sf::IntRect rect;
+    };
+
+    // Pack the small images of directory into atlas pages; later lookups
+    // of those images are served from the pages
+    static void buildAtlas(const std::string &directory);
+    static TextureRegion getRegion(const std::string &texturePath);
     static sf::Texture &getTexture(const std::string &texturePath);
     static bool getTextureifExists(const std::string &texturePath);
+    static sf::Vector2u getTextureSize(const std::string &texturePath);
+    static void setSpriteTexture(sf::Sprite &sprite,
+                                 const std::string &texturePath);
     static void loadGameFont(const std::string &fontPath);
     static void loadPageFont(const std::string &fontPath);
     static void loadBackgroundMusic(const std::string &filePath);
     static void playSound(const std::string &filePath);
     static void updateSounds();
 
+    // In headless mode no texture is uploaded and no sound is played;
+    // sprites only receive a texture rect so that bounds stay correct
+    static void setHeadless(bool enabled);
+    static bool isHeadless();
+
     static sf::Font gameFont;
     static sf::Font pageFont;
     static sf::Music gameBackgroundMusic;
@@ -60,6 +81,9 @@ private:
     static std::unordered_map<std::string, sf::Texture> textures;
     static std::unordered_map<std::string, sf::SoundBuffer> soundBuffers;
     static std::vector<std::unique_ptr<sf::Sound>> activeSounds;
+    static std::unordered_map<std::string, sf::Vector2u> textureSizes;
+    static bool headless;
+    static TextureAtlas atlas;
 
     static constexpr size_t MAX_CONCURRENT_SOUNDS = 16;
 };
\ No newline at end of file
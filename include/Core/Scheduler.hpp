@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Hierarchical timer wheel driven by the simulation tick.
+//
+// Tasks are bucketed by expiry tick on four wheels of 64 slots each, so a
+// tick only touches the callbacks that are due plus an occasional cascade
+// from a coarser wheel. A callback returns the delay in seconds until it
+// wants to run again, or a value <= 0 to finish.
+class Scheduler {
+public:
+    using Callback = std::function<float()>;
+
+    // Owns a scheduled task and cancels it when destroyed or reassigned
+    class Handle {
+    public:
+        Handle() = default;
+        ~Handle() { cancel(); }
+
+        Handle(Handle &&other) noexcept { *this = std::move(other); }
+        Handle &operator=(Handle &&other) noexcept;
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+
+        void cancel();
+        bool isPending() const;
+
+    private:
+        friend class Scheduler;
+        Handle(Scheduler *scheduler, uint32_t index, uint32_t generation)
+            : scheduler(scheduler), index(index), generation(generation) {}
+
+        Scheduler *scheduler = nullptr;
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+
+    explicit Scheduler(float tickSeconds);
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    // Run callback after delaySeconds (at least one tick)
+    [[nodiscard]] Handle schedule(float delaySeconds, Callback callback);
+
+    // Advance by one tick and run every callback that became due
+    void advance();
+
+    size_t getPendingCount() const { return pendingCount; }
+    uint64_t getFiredCount() const { return firedCount; }
+
+private:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+    static constexpr uint64_t MAX_DELAY_TICKS =
+        (1ull << (SLOT_BITS * LEVELS)) - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr uint16_t UNLINKED = UINT16_MAX;
+
+    struct Task {
+        Callback callback;
+        uint64_t expiry = 0;
+        uint32_t generation = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint16_t bucket = UNLINKED;
+        bool live = false;
+    };
+
+    uint64_t toTicks(float seconds) const;
+    bool isCurrent(uint32_t index, uint32_t generation) const;
+    void cancel(uint32_t index, uint32_t generation);
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(unsigned level);
+    void fire();
+
+    float ticksPerSecond;
+    uint64_t currentTick = 0;
+    size_t pendingCount = 0;
+    uint64_t firedCount = 0;
+
+    std::vector<Task> tasks;
+    std::vector<uint32_t> freeList;
+    std::array<uint32_t, LEVELS * SLOTS> buckets;
+    std::vector<std::pair<uint32_t, uint32_t>> due;
+};
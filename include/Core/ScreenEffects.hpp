@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "ResourceManager.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// Full-screen layers requested while a frame is drawn and composited once.
+// Flashes of one colour merge into a single fill at the strongest of their
+// alphas, and each image is drawn once however often it was requested, so
+// overlapping explosions cost as much fill as a single one.
+class ScreenEffects {
+public:
+    // Requests made and full-screen layers drawn, see draw()
+    struct Stats {
+        size_t requests = 0ul;
+        size_t layers = 0ul;
+    };
+
+    // Flashes last this long and fade out along fade()
+    static constexpr float FLASH_DURATION = 0.3f;
+
+    // Fill the screen with color, elapsed seconds into the flash
+    void flash(sf::Color color, float elapsed);
+    // Cover the screen with the image of region
+    void overlay(const ResourceManager::TextureRegion &region);
+    // Draw the flashes, then the images over them, and forget the requests
+    void draw(sf::RenderTarget &target);
+
+    const Stats &getStats() const { return stats; }
+    void resetStats() { stats = {}; }
+
+private:
+    // Share of the alpha left at progress through a flash, from 1 to 0
+    static float fade(float progress);
+
+    std::vector<sf::Color> flashes; // one per colour
+    std::vector<ResourceManager::TextureRegion> images;
+    Stats stats;
+};
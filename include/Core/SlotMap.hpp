@@ -0,0 +1,144 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Maps stable handles to dense indices [0, size()). Each handle goes through
+// a slot that records its dense index and a generation, so insert() and
+// eraseAt() are O(1) and a handle to an erased entry is detected instead of
+// aliasing whatever reuses the slot. The owner keeps its values in dense
+// arrays and mirrors every insert() and eraseAt() on them.
+class SlotIndex {
+public:
+    struct Handle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool operator==(const Handle &) const = default;
+    };
+
+    // Appends an entry at dense index size() - 1
+    Handle insert();
+    // Moves the last entry into denseIndex, the owner has to do the same
+    void eraseAt(size_t denseIndex);
+
+    bool contains(Handle handle) const {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation;
+    }
+    // Only meaningful when contains(handle)
+    size_t indexOf(Handle handle) const { return slots[handle.index].dense; }
+    Handle handleAt(size_t denseIndex) const;
+
+    void reserve(size_t capacity);
+    size_t size() const { return denseToSlot.size(); }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Slot {
+        uint32_t dense;      // index into the dense arrays, or next free slot
+        uint32_t generation; // bumped on erase, invalidating old handles
+    };
+
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    uint32_t freeHead = NIL;
+};
+
+// Values live contiguously so that iteration is a plain walk over a vector,
+// and are addressed from outside through SlotIndex handles
+template <typename T> class SlotMap {
+public:
+    using Handle = SlotIndex::Handle;
+
+    Handle insert(T value) {
+        values.push_back(std::move(value));
+        return index.insert();
+    }
+
+    // Returns null when the handle is stale or was never inserted
+    T *get(Handle handle) {
+        return contains(handle) ? &values[index.indexOf(handle)] : nullptr;
+    }
+    const T *get(Handle handle) const {
+        return contains(handle) ? &values[index.indexOf(handle)] : nullptr;
+    }
+
+    bool contains(Handle handle) const { return index.contains(handle); }
+
+    bool erase(Handle handle) {
+        if (!contains(handle))
+            return false;
+        eraseAt(index.indexOf(handle));
+        return true;
+    }
+
+    // Moves the last value into the hole, so during a walk the value at
+    // denseIndex has to be visited again
+    void eraseAt(size_t denseIndex) {
+        if (denseIndex + 1 != values.size())
+            values[denseIndex] = std::move(values.back());
+        values.pop_back();
+        index.eraseAt(denseIndex);
+    }
+
+    // Erases every value for which pred returns true, returns how many
+    template <typename Pred> size_t eraseIf(Pred pred) {
+        size_t erased = 0ul;
+        for (size_t i = 0; i < values.size();) {
+            if (pred(values[i])) {
+                eraseAt(i);
+                erased++;
+            } else
+                ++i;
+        }
+        return erased;
+    }
+
+    Handle handleAt(size_t denseIndex) const {
+        return index.handleAt(denseIndex);
+    }
+
+    void clear() {
+        while (!values.empty())
+            eraseAt(values.size() - 1);
+    }
+
+    void reserve(size_t capacity) {
+        values.reserve(capacity);
+        index.reserve(capacity);
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    T &operator[](size_t denseIndex) { return values[denseIndex]; }
+    const T &operator[](size_t denseIndex) const { return values[denseIndex]; }
+
+    auto begin() { return values.begin(); }
+    auto end() { return values.end(); }
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.end(); }
+
+private:
+    std::vector<T> values;
+    SlotIndex index;
+};
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "CpuDispatch.hpp"
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Boxes looked at by SpatialGrid queries, and those that intersected the
+// area
+struct QueryStats {
+    uint64_t candidates = 0;
+    uint64_t hits = 0;
+
+    QueryStats &operator+=(const QueryStats &other) {
+        candidates += other.candidates;
+        hits += other.hits;
+        return *this;
+    }
+};
+
+// Uniform grid broad-phase over the arena.
+//
+// Boxes are inserted with an id, then build() buckets them into cells with
+// a counting sort. A query only looks at the cells overlapped by the area
+// and reports every id whose box intersects it exactly once: a box is only
+// considered in the top-left cell it shares with the area. Boxes outside
+// the arena are clamped into the border cells. The edges of the boxes are
+// copied out per cell, so a cell is tested against the area in one batch by
+// CpuDispatch::overlap.
+//
+// Queries do not modify the grid, so several threads may run them at once
+// between two builds.
+class SpatialGrid {
+public:
+    SpatialGrid(float width, float height, float cellSize);
+
+    void clear();
+    void insert(uint32_t id, const sf::FloatRect &bounds);
+    void build();
+
+    template <typename Visitor>
+    void query(const sf::FloatRect &area, Visitor &&visit,
+               QueryStats &stats) const;
+
+private:
+    struct CellRange {
+        int left, top, right, bottom;
+    };
+    CellRange cellRange(const sf::FloatRect &bounds) const;
+
+    float cellSize;
+    int columns;
+    int rows;
+
+    std::vector<uint32_t> ids;
+    std::vector<sf::FloatRect> boxes;
+    std::vector<CellRange> spans;    // cells covered by each box
+    std::vector<uint32_t> cellStart; // columns * rows + 1 offsets
+    std::vector<uint32_t> cellItems; // indices into ids/boxes
+    // Edges of the box of each entry of cellItems
+    std::vector<float> itemLeft, itemTop, itemRight, itemBottom;
+    std::vector<uint32_t> cursors;   // scratch for build()
+};
+
+template <typename Visitor>
+void SpatialGrid::query(const sf::FloatRect &area, Visitor &&visit,
+                        QueryStats &stats) const {
+    if (boxes.empty())
+        return;
+
+    const CellRange range = cellRange(area);
+    uint64_t candidates = 0;
+    uint64_t hits = 0;
+    for (int y = range.top; y <= range.bottom; y++) {
+        for (int x = range.left; x <= range.right; x++) {
+            const size_t cell = (size_t)y * columns + x;
+            for (uint32_t batch = cellStart[cell]; batch < cellStart[cell + 1];
+                 batch += 64u) {
+                const size_t count =
+                    std::min<size_t>(64u, cellStart[cell + 1] - batch);
+                const uint64_t overlaps = CpuDispatch::overlap(
+                    &itemLeft[batch], &itemTop[batch], &itemRight[batch],
+                    &itemBottom[batch], count, area);
+                for (size_t i = 0; i < count; i++) {
+                    const uint32_t item = cellItems[batch + i];
+                    const CellRange &span = spans[item];
+                    if (x != std::max(span.left, range.left) ||
+                        y != std::max(span.top, range.top))
+                        continue;
+                    candidates++;
+                    if (overlaps >> i & 1u) {
+                        hits++;
+                        visit(ids[item]);
+                    }
+                }
+            }
+        }
+    }
+    stats.candidates += candidates;
+    stats.hits += hits;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// Collects sprites into one triangle list per texture, so that a frame
+// issues a draw call per texture rather than per sprite.
+//
+// Sprites queued between two flushes are drawn grouped by texture, in the
+// order each texture was first queued, so overlapping sprites of different
+// textures may swap. Vertex storage is kept from frame to frame.
+class SpriteBatch {
+public:
+    // Sprites queued and draw calls issued, see flush()
+    struct Stats {
+        size_t sprites = 0ul;
+        size_t drawCalls = 0ul;
+    };
+
+    // Queue sprite as window.draw(sprite) would draw it now
+    void add(const sf::Sprite &sprite);
+    // Queue rect of texture as a sprite with transform would show it
+    void add(const sf::Texture *texture, const sf::IntRect &rect,
+             const sf::Transform &transform,
+             sf::Color color = sf::Color::White);
+    // Queue count untransformed quads of halfSize centred on (x[i], y[i]),
+    // all showing textureRect of texture
+    void addQuads(const sf::Texture *texture, const sf::IntRect &textureRect,
+                  sf::Vector2f halfSize, const float *x, const float *y,
+                  size_t count, sf::Color color = sf::Color::White);
+    // Draw and empty every batch
+    void flush(sf::RenderTarget &target);
+
+    const Stats &getStats() const { return stats; }
+    void resetStats() { stats = {}; }
+
+private:
+    struct Batch {
+        const sf::Texture *texture;
+        std::vector<sf::Vertex> vertices;
+    };
+    // The batch of texture, added if needed
+    std::vector<sf::Vertex> &verticesOf(const sf::Texture *texture);
+
+    std::vector<Batch> batches; // in order of first use since the flush
+    size_t batchCount = 0ul;
+    Stats stats;
+};
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "JobSystem.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// A fixed set of named tasks and the tasks each must wait for, run as jobs
+// on a JobSystem. A task is submitted as soon as the last task it waits for
+// finishes, so tasks without a path between them may overlap. Every task
+// keeps the time it spent across runs.
+class TaskGraph {
+public:
+    using TaskId = size_t;
+
+    struct Timing {
+        std::string name;
+        double seconds; // over every run
+        uint64_t runs;
+    };
+
+    // The tasks in after must have been added before
+    TaskId add(std::string name, std::function<void()> work,
+               std::initializer_list<TaskId> after = {});
+    // Runs every task once and returns when all are done
+    void run(JobSystem &jobs);
+
+    std::vector<Timing> getTimings() const;
+
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> work;
+        std::vector<TaskId> dependents;
+        size_t dependencies = 0ul;
+        std::atomic<size_t> waiting{0ul}; // dependencies left in this run
+        double seconds = 0.0;
+        uint64_t runs = 0ul;
+    };
+
+    void launch(JobSystem &jobs, JobSystem::Group &group, TaskId id);
+
+    std::deque<Task> tasks; // atomics cannot move, so no vector
+};
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Packs small images into a few large textures ("pages"), so that sprites
+// showing different images can share a texture and be drawn in one batch.
+//
+// Images are queued with add() and packed by build(); a region is the page
+// and the rect an image landed on.
+class TextureAtlas {
+public:
+    struct Region {
+        size_t page;
+        sf::IntRect rect;
+    };
+
+    // Transparent pixels between packed images, so that a sprite never
+    // samples its neighbour
+    static constexpr unsigned PADDING = 2u;
+
+    explicit TextureAtlas(unsigned pageSize);
+
+    // Queue image under name; false if it is too large for a page
+    bool add(const std::string &name, const sf::Image &image);
+    // Pack the queued images and upload the pages, once
+    void build();
+
+    // The region of name, null if it was not packed
+    const Region *find(const std::string &name) const;
+    const sf::Texture &getPage(size_t page) const { return pages[page]; }
+    size_t getPageCount() const { return pages.size(); }
+    size_t size() const { return regions.size(); }
+
+private:
+    struct Pending {
+        std::string name;
+        sf::Image image;
+    };
+
+    unsigned pageSize;
+    std::vector<Pending> pending;
+    std::unordered_map<std::string, Region> regions;
+    std::deque<sf::Texture> pages; // sprites keep pointers to these
+};
@@ -15,7 +15,6 @@
  */
 
 #pragma once
-#include <SFML/System/Clock.hpp>
 
 class Timer {
 public:
@@ -26,6 +25,6 @@ public:
     bool hasElapsed(float seconds) const;
 
 private:
-    mutable sf::Clock clock;
-    float offset;
+    // GameClock::now() at the moment the timer read zero
+    double start;
 };
@@ -15,10 +15,23 @@
  */
 
 #pragma once
+#include "../Core/ResourceManager.hpp"
+#include "../Core/SpriteBatch.hpp"
 #include "../Core/Timer.hpp"
+#include "EffectSystem.hpp"
 #include "Entity.hpp"
 #include <SFML/Graphics.hpp>
 
+// What every bullet showing one image shares: it is drawn from region,
+// turning about origin, the middle of its bottom edge
+struct BulletFrame {
+    ResourceManager::TextureRegion region;
+    sf::Vector2f size;
+    sf::Vector2f origin;
+};
+
+// A bullet only holds its transform and the frame it shows; the quad is
+// built when the frame is drawn
 class Bullet : public Entity {
 public:
     Bullet() = default;
@@ -27,10 +40,15 @@ public:
 
     using Entity::update;
     virtual void update(float deltaTime, sf::Vector2f hitTarget);
-    virtual void render(sf::RenderWindow &window) override;
-    virtual void explode();
+    // Queue the bullet itself
+    void render(SpriteBatch &batch, float alpha) const;
+    // Leave a blast behind; the bullet itself is gone once destroyed
+    virtual void explode(EffectSystem &effects);
     virtual void explodeSoundOnly();
 
+    sf::FloatRect getBounds() const override;
+    sf::Vector2f getPosition() const override { return position; }
+
     virtual boost::json::object serialize() const override;
     virtual void deserialize(const boost::json::object &o) override;
 
@@ -38,43 +56,42 @@ public:
     float damage;
     float damageRate;
     Timer timer;
-    bool exploding = false;
     bool charming = false;
 
+    static constexpr const char *bullets_path[6] = {
+        "assets/bullet1.png", "assets/bullet2.png", "assets/missle.png",
+        "assets/rocket.png",  "assets/bullet3.png", "assets/bullet4.png"};
+
 protected:
+    void setPosition(sf::Vector2f position) override {
+        this->position = position;
+    }
+    // Show image id of bullets_path
+    void setFrame(size_t id);
     void updateRotation();
+    // Where and how the frame is drawn with the bullet at position
+    sf::Transform getTransform(sf::Vector2f position) const;
 
-    const char *bullets_path[6] = {"assets/bullet1.png", "assets/bullet2.png",
-                                   "assets/missle.png",  "assets/rocket.png",
-                                   "assets/bullet3.png", "assets/bullet4.png"};
+    sf::Vector2f position;
+    float rotation = 0.0f; // degrees, in [0, 360) like sf::Transformable
     sf::Vector2f direction;
     float speed;
     size_t id;
+    const BulletFrame *frame = nullptr;
 
 private:
     Bullet(const Bullet &) = delete;
     Bullet &operator=(const Bullet &) = delete;
 };
 
-class Cannon : public Bullet {
-public:
-    Cannon(const boost::json::object &o);
-    Cannon(sf::Vector2f position, sf::Vector2f direction, size_t id,
-           bool from_player, float speed, float damage, bool charming);
-
-    boost::json::object serialize() const override;
-    void deserialize(const boost::json::object &o) override;
-};
-
-class Missile : public Bullet {
+class Missile final : public Bullet {
 public:
     Missile(const boost::json::object &o);
     Missile(sf::Vector2f position, sf::Vector2f direction, size_t id,
             bool from_player, float speed, float damage, float tracking);
 
     void update(float deltaTime, sf::Vector2f hitTarget) override;
-    void render(sf::RenderWindow &window) override;
-    void explode() override;
+    void explode(EffectSystem &effects) override;
     void explodeSoundOnly() override;
 
     boost::json::object serialize() const override;
@@ -82,20 +99,16 @@ public:
 
 private:
     float tracking;
-    sf::RectangleShape whiteFlash;
-    sf::Sprite explodeSprite;
-    Timer explodeTimer;
 };
 
-class Rocket : public Bullet {
+class Rocket final : public Bullet {
 public:
     Rocket(const boost::json::object &o);
     Rocket(sf::Vector2f position, sf::Vector2f direction, size_t id,
            bool from_player, float speed, float damage);
 
     void update(float deltaTime, sf::Vector2f hitTarget) override;
-    void render(sf::RenderWindow &window) override;
-    void explode() override;
+    void explode(EffectSystem &effects) override;
     void explodeSoundOnly() override;
 
     boost::json::object serialize() const override;
@@ -103,7 +116,4 @@ public:
 
 private:
     float tracking;
-    sf::RectangleShape redFlash;
-    sf::Sprite explodeSprite;
-    Timer explodeTimer;
 };
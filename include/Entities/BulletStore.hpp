@@ -0,0 +1,232 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/Constants.hpp"
+#include "../Core/ObjectPool.hpp"
+#include "../Core/RandomUtils.hpp"
+#include "../Core/SlotMap.hpp"
+#include "../Core/SpatialGrid.hpp"
+#include "Bullet.hpp"
+#include "BulletSystem.hpp"
+#include "CollisionLayers.hpp"
+#include "Volley.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// A bullet found by BulletStore::query(): either a straight-line bullet in
+// a BulletSystem or a Missile/Rocket object
+class BulletRef {
+public:
+    float getDamage() const {
+        return object ? object->damage : system->getDamage(index);
+    }
+    float getDamageRate() const { return object ? object->damageRate : 0.0f; }
+    bool isCharming() const { return charming; }
+    bool isAlive() const {
+        return object ? object->isAvailable() : system->isAlive(index);
+    }
+
+    void explode(EffectSystem &effects) {
+        if (object)
+            object->explode(effects);
+    }
+    void explodeSoundOnly() {
+        if (object)
+            object->explodeSoundOnly();
+    }
+    void destroy() {
+        if (object)
+            object->setAvailable(false);
+        else
+            system->kill(index);
+    }
+
+private:
+    friend class BulletStore;
+    BulletRef(Bullet *object, BulletSystem *system, uint32_t index,
+              bool charming)
+        : object(object), system(system), index(index), charming(charming) {}
+
+    Bullet *object;
+    BulletSystem *system;
+    uint32_t index;
+    bool charming;
+};
+
+// What to do with a new straight-line bullet when the store is full
+enum class OverflowPolicy : uint8_t {
+    DropNewest, // discard the new bullet
+    DropOldest, // kill the oldest bullet of the same layer to make room
+    // Refuse hostile bullets once BULLET_HOSTILE_SHARE of the capacity is in
+    // use, keeping the rest for the player; drop newest when full
+    RefuseHostileFirst,
+};
+
+struct BulletPoolConfig {
+    size_t capacity = Constants::BULLET_CAPACITY; // straight-line bullets
+    size_t objectCapacity = Constants::BULLET_OBJECT_CAPACITY; // the others
+    OverflowPolicy policy = OverflowPolicy::RefuseHostileFirst;
+};
+
+// Live bullets, kept apart per BulletLayer so that a collider only visits
+// the layers that can hit it. Each layer holds its straight-line bullets in
+// a BulletSystem, its Missiles and Rockets as objects bucketed by type, and
+// a collision grid over all of them. Every bucket is updated by its own
+// loop on the final type, so the calls are not virtual.
+//
+// All storage is allocated up front from a BulletPoolConfig. Straight-line
+// bullets share one capacity across the layers, governed by the overflow
+// policy. Missiles and Rockets come from a fixed ObjectPool and are dropped
+// when it runs out.
+class BulletStore {
+public:
+    explicit BulletStore(const BulletPoolConfig &config = {});
+
+    // Emit every bullet of volley in one go; bullets that do not fit are
+    // dropped one by one as the overflow policy says. The spread of the
+    // volley is drawn from random.
+    void fire(const Volley &volley, const Shooter &shooter,
+              RandomStream &random);
+    void addCannon(const boost::json::object &o);
+    template <typename T, typename... Args> void add(Args &&...args);
+    void clear();
+    size_t size() const;
+    // Bullets refused or evicted because the store was full
+    uint64_t getDroppedCount() const { return dropped; }
+
+    // Move the live bullets and drop the ones that are gone
+    void update(float deltaTime, sf::Vector2f hitTarget);
+    // Bucket the live bullets of every layer for query()
+    void rebuildGrids();
+    // Every bullet goes through batch, which is flushed
+    void render(sf::RenderWindow &window, SpriteBatch &batch, float alpha);
+    boost::json::array serialize() const;
+
+    // Visit the live bullets that overlap area and can hit collider
+    template <typename Visitor>
+    void query(ColliderLayer collider, const sf::FloatRect &area,
+               Visitor &&visit) {
+        query(collider, area, visit, queryStats);
+    }
+    // Same, counting into stats. Several threads may query at once with
+    // their own stats as long as no bullet is added, moved or destroyed
+    // meanwhile; hand the stats back with addQueryStats() afterwards.
+    template <typename Visitor>
+    void query(ColliderLayer collider, const sf::FloatRect &area,
+               Visitor &&visit, QueryStats &stats);
+    void addQueryStats(const QueryStats &stats) { queryStats += stats; }
+
+    uint64_t getCandidateCount() const { return queryStats.candidates; }
+    uint64_t getHitCount() const { return queryStats.hits; }
+
+private:
+    // Grid ids carry the kind of bullet in the top two bits and the index
+    // into the cannons or the bucket of that kind below them
+    enum Kind : uint32_t { CANNON, MISSILE, ROCKET };
+    static constexpr uint32_t KIND_SHIFT = 30;
+    static constexpr uint32_t INDEX_MASK = (1u << KIND_SHIFT) - 1;
+
+    using BulletPool = ObjectPool<Bullet, Missile, Rocket>;
+    template <typename T> using Bucket = SlotMap<BulletPool::PointerTo<T>>;
+
+    struct Layer {
+        Layer(bool from_player, const BulletPoolConfig &config);
+
+        BulletSystem cannons;
+        Bucket<Missile> missiles;
+        Bucket<Rocket> rockets;
+        SpatialGrid grid;
+    };
+
+    // Calls f(bucket, kind) on every object bucket of layer
+    template <typename L, typename F>
+    static void forEachBucket(L &layer, F &&f) {
+        f(layer.missiles, MISSILE);
+        f(layer.rockets, ROCKET);
+    }
+    template <typename T> static Bucket<T> &bucketOf(Layer &layer) {
+        if constexpr (std::is_same_v<T, Missile>)
+            return layer.missiles;
+        else
+            return layer.rockets;
+    }
+    template <typename T, typename Visitor>
+    static void visitObject(Bucket<T> &bucket, uint32_t index, bool charming,
+                            Visitor &visit);
+
+    Layer &layerFor(bool from_player, bool charming);
+    size_t getLiveCannonCount() const;
+    // Whether a straight-line bullet may be added to layer, evicting
+    // another one first if the policy says so. live counts the straight-line
+    // bullets of every layer and is updated for the one being added.
+    bool makeRoom(BulletLayer layer, size_t &live);
+
+    BulletPoolConfig config;
+    uint64_t dropped = 0ul;
+    QueryStats queryStats;
+    BulletPool objectPool; // must outlive the layers
+    std::vector<Layer> layers;
+};
+
+template <typename T, typename... Args> void BulletStore::add(Args &&...args) {
+    BulletPool::PointerTo<T> bullet =
+        objectPool.create<T>(std::forward<Args>(args)...);
+    if (!bullet) {
+        dropped++;
+        return;
+    }
+    Layer &layer = layerFor(bullet->from_player, bullet->charming);
+    bucketOf<T>(layer).insert(std::move(bullet));
+}
+
+template <typename T, typename Visitor>
+void BulletStore::visitObject(Bucket<T> &bucket, uint32_t index, bool charming,
+                              Visitor &visit) {
+    T &bullet = *bucket[index];
+    if (bullet.isAvailable())
+        visit(BulletRef(&bullet, nullptr, 0, charming));
+}
+
+template <typename Visitor>
+void BulletStore::query(ColliderLayer collider, const sf::FloatRect &area,
+                        Visitor &&visit, QueryStats &stats) {
+    for (size_t i = 0; i < layers.size(); i++) {
+        if (!CollisionLayers::canHit((BulletLayer)i, collider))
+            continue;
+        Layer &layer = layers[i];
+        const bool charming = (BulletLayer)i == BulletLayer::Charm;
+        auto visitId = [&](uint32_t id) {
+            const uint32_t index = id & INDEX_MASK;
+            switch (id >> KIND_SHIFT) {
+                case CANNON:
+                    if (layer.cannons.isAlive(index))
+                        visit(BulletRef(nullptr, &layer.cannons, index,
+                                        charming));
+                    break;
+                case MISSILE:
+                    visitObject(layer.missiles, index, charming, visit);
+                    break;
+                case ROCKET:
+                    visitObject(layer.rockets, index, charming, visit);
+                    break;
+            }
+        };
+        layer.grid.query(area, visitId, stats);
+    }
+}
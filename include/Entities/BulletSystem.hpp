@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/ISerializable.hpp"
+#include "../Core/ResourceManager.hpp"
+#include "../Core/SpriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Straight-line bullets ("Cannon" in saves) stored as structure of arrays.
+//
+// Positions and velocities live in contiguous float arrays so that the
+// integration and arena culling in update() run as a SIMD kernel, picked
+// for the CPU by CpuDispatch. All bullets of one system belong to the same
+// faction, see BulletStore.
+//
+// The arrays are allocated once for a fixed number of slots. Dead slots go
+// on a free list and are parked at rest inside the arena, so the kernels can
+// run over them without reviving or culling them again.
+class BulletSystem {
+public:
+    BulletSystem(bool from_player, size_t capacity);
+
+    // Both return false when every slot is taken
+    bool spawn(sf::Vector2f position, sf::Vector2f direction, size_t id,
+               float speed, float damage);
+    bool spawn(const boost::json::object &o);
+    boost::json::object serialize(uint32_t index) const;
+
+    // Move the live bullets and release those that left the arena
+    void update(float deltaTime);
+    // Queue the live bullets on batch, one run of quads per texture
+    void render(SpriteBatch &batch, float alpha);
+    void clear();
+
+    // Kill the longest-lived bullet, false if there is none
+    bool killOldest();
+    void kill(uint32_t index);
+
+    // Slots [0, getSlotCount()) may hold live bullets
+    size_t getSlotCount() const { return slotCount; }
+    size_t getLiveCount() const { return liveCount; }
+    bool isAlive(uint32_t index) const { return alive[index]; }
+    float getDamage(uint32_t index) const { return damage[index]; }
+    sf::FloatRect getBounds(uint32_t index) const;
+
+private:
+    static constexpr size_t TEXTURE_COUNT = 6;
+
+    bool from_player;
+    std::array<sf::Vector2f, TEXTURE_COUNT> halfSizes;
+    std::array<ResourceManager::TextureRegion, TEXTURE_COUNT> regions{};
+    // Interpolated centres per texture, scratch for render()
+    std::array<std::vector<float>, TEXTURE_COUNT> drawX, drawY;
+
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;
+    std::vector<float> vx, vy;
+    std::vector<float> damage;
+    std::vector<uint8_t> id;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> generation;
+
+    size_t slotCount = 0ul;
+    size_t liveCount = 0ul;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> culled;
+
+    // Slots in spawn order as (generation << 32 | slot). Entries of bullets
+    // that died otherwise are skipped by killOldest() and dropped when the
+    // ring fills up.
+    std::vector<uint64_t> spawnOrder;
+    size_t spawnOrderHead = 0ul;
+    size_t spawnOrderCount = 0ul;
+};
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Bullets are grouped by faction, colliders by what they can be hit by
+enum class BulletLayer : uint8_t {
+    Player,  // fired by the player or by charmed enemies
+    Hostile, // fired by enemies
+    Charm,   // fired by the player while AllMyPeople is active
+};
+
+enum class ColliderLayer : uint8_t {
+    Player,
+    Enemy,
+    CharmedEnemy,
+};
+
+namespace CollisionLayers {
+constexpr size_t BULLET_LAYER_COUNT = 3;
+constexpr size_t COLLIDER_LAYER_COUNT = 3;
+
+// clang-format off
+constexpr std::array<std::array<bool, BULLET_LAYER_COUNT>,
+                     COLLIDER_LAYER_COUNT> MATRIX = {{
+    //                 Player  Hostile  Charm
+    /* Player       */ {false, true,    false},
+    /* Enemy        */ {true,  false,   true },
+    /* CharmedEnemy */ {false, true,    false},
+}};
+// clang-format on
+
+constexpr bool canHit(BulletLayer bullet, ColliderLayer collider) {
+    return MATRIX[(size_t)collider][(size_t)bullet];
+}
+
+constexpr BulletLayer layerOf(bool from_player, bool charming) {
+    if (!from_player)
+        return BulletLayer::Hostile;
+    return charming ? BulletLayer::Charm : BulletLayer::Player;
+}
+} // namespace CollisionLayers
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/ParticleSystem.hpp"
+#include "../Core/ResourceManager.hpp"
+#include "../Core/ScreenEffects.hpp"
+#include "../Core/SpriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class BlastKind { Missile, Rocket };
+
+// Visual effects that outlive what caused them: the blasts of spent
+// missiles and rockets and the death animations of enemies. The bullet or
+// enemy leaves the simulation at once and only its effect carries on.
+//
+// Effects live in pools of fixed capacity and are advanced once per
+// rendered frame, not per tick; a full pool drops new effects. Nothing is
+// kept when running headless.
+class EffectSystem {
+public:
+    EffectSystem();
+
+    // A flash over the screen, then the explosion image, with sparks
+    void blast(BlastKind kind, sf::Vector2f position);
+    // Show each of count frames in turn at position, drifting at velocity
+    // and turned 180 degrees if flipped, with sparks
+    void playFrames(const ResourceManager::TextureRegion *frames, size_t count,
+                    sf::Vector2f position, sf::Vector2f velocity, bool flipped,
+                    sf::Color color);
+
+    void update(float deltaTime);
+    // Composite the blasts through screen, then draw the animations and the
+    // sparks through batch and flush it
+    void render(sf::RenderWindow &window, SpriteBatch &batch,
+                ScreenEffects &screen);
+    void clear();
+
+    size_t size() const;
+    // Effects and particles dropped because their pool was full
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Blast {
+        BlastKind kind;
+        float age; // seconds
+    };
+    struct Animation {
+        const ResourceManager::TextureRegion *frames;
+        size_t count;
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        bool flipped;
+        sf::Color color;
+        float age; // seconds
+    };
+
+    std::vector<Blast> blasts;
+    std::vector<Animation> animations;
+    ParticleSystem particles;
+    uint64_t dropped = 0ul;
+};
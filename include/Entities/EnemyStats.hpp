@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/Constants.hpp"
+#include <array>
+
+// Bounds a stat is drawn from when an enemy spawns; min == max is fixed
+struct StatRange {
+    float min = 0.0f;
+    float max = 0.0f;
+
+    constexpr bool isFixed() const { return min == max; }
+};
+
+// What an enemy of one level spawns with
+struct EnemyStats {
+    StatRange health;
+    StatRange speed;
+    float bulletSpeedScale = 0.0f; // bullet speed as a multiple of speed
+    StatRange bulletSpeed;         // used when bulletSpeedScale is 0
+    StatRange shotGap;
+    float damage = 0.0f;
+    float killBonus = 0.0f;
+    float killBonusHealthShare = 0.0f; // of maxHealth, on top of killBonus
+    StatRange weaveAmplitude;          // for kinds that weave
+    StatRange weaveFrequency;
+    float regenRate = 0.0f; // for kinds that regenerate
+    float hoverLine = 0.0f; // charmed enemies stop climbing here, as a
+                            // fraction of the screen height
+};
+
+// clang-format off
+inline constexpr std::array<EnemyStats, Constants::ENEMY_LEVEL_COUNT + 1ul>
+    ENEMY_STATS = {{
+    {}, // levels start at 1
+    {   // Enemy I
+        .health = {2048.0f, 2048.0f},
+        .speed = {128.0f, 256.0f},
+        .bulletSpeedScale = 3.2f,
+        .shotGap = {0.2f, 0.2f},
+        .damage = 512.0f,
+        .killBonus = 5000.0f,
+        .hoverLine = 2.0f / 3.0f,
+    },
+    {   // Enemy II
+        .health = {16384.0f, 16384.0f},
+        .speed = {64.0f, 256.0f},
+        .bulletSpeedScale = 4.0f,
+        .shotGap = {0.1f, 0.1f},
+        .damage = 728.0f,
+        .killBonus = 10000.0f,
+        .weaveAmplitude = {128.0f, 256.0f},
+        .weaveFrequency = {0.5f, 1.5f},
+        .hoverLine = 4.0f / 5.0f,
+    },
+    {   // Enemy III, the boss
+        .health = {840000.0f, 1200000.0f},
+        .speed = {16.0f, 32.0f},
+        .bulletSpeed = {1024.0f, 2048.0f},
+        .shotGap = {0.2f, 0.28f},
+        .damage = 4096.0f,
+        .killBonusHealthShare = 1.0f,
+        .weaveAmplitude = {128.0f, 256.0f},
+        .weaveFrequency = {0.6f, 1.2f},
+        .regenRate = 1000.0f,
+    },
+}};
+// clang-format on
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/Archetype.hpp"
+#include "../Core/Constants.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/RandomUtils.hpp"
+#include "../Core/ResourceManager.hpp"
+#include "../Core/Scheduler.hpp"
+#include "../Core/SpriteBatch.hpp"
+#include "BulletStore.hpp"
+#include "EffectSystem.hpp"
+#include "EnemyStats.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <boost/json.hpp>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Enemy components. Everything but Visual is read by the per-tick systems;
+// Visual is only touched to render or when the frame changes.
+struct Motion {
+    sf::Vector2f position;
+    sf::Vector2f previous; // at the start of the tick, for interpolation
+    sf::Vector2f size;     // of the sprite, for the bounds
+    float speed;
+};
+
+// Sideways sine motion around center
+struct Weave {
+    float amplitude;
+    float frequency;
+    float center;
+    float time; // seconds since spawning
+};
+
+struct Vitals {
+    float health;
+    float maxHealth;
+    float killBonus;
+};
+
+// Health regained per second, up to twice maxHealth
+struct Regen {
+    float rate;
+};
+
+struct Weapon {
+    float bulletSpeed;
+    float shotGap;
+    float damage;
+    RandomStream random; // of the enemy, first drawn for its stats
+};
+
+struct Status {
+    bool avail;
+    bool charmed;
+    bool bonusTaken;
+};
+
+// The images themselves are shared by the enemies of a level, see
+// EnemyPrefab
+struct Visual {
+    uint16_t frame; // into EnemyPrefab::frames
+    Scheduler::Handle shotTask;
+};
+
+// Movement policies, moving the enemies in rows [begin, end). Rows are
+// independent, so ranges may be moved on different threads.
+// Straight down, weaving if the kind has a Weave. Charmed enemies fly up and
+// hold at the hover line of their level.
+struct DiveMovement {
+    template <typename Kind>
+    static void move(Kind &enemies, size_t begin, size_t end, float deltaTime);
+};
+// Weaves, and only descends once below a quarter of the screen
+struct BossMovement {
+    template <typename Kind>
+    static void move(Kind &enemies, size_t begin, size_t end, float deltaTime);
+};
+
+// Gun policies, fired by the Scheduler every shotGap seconds
+// One bullet straight ahead
+struct SingleShotGun {
+    static void fire(BulletStore &bullets, const sf::FloatRect &bounds,
+                     const Vitals &vitals, Weapon &weapon,
+                     const Status &status);
+};
+// A six-bullet spread, with missile or rocket pairs every few volleys
+struct VolleyGun {
+    static void fire(BulletStore &bullets, const sf::FloatRect &bounds,
+                     const Vitals &vitals, Weapon &weapon,
+                     const Status &status);
+};
+
+// Enemy kinds: the archetype of one level plus its behaviour. Stats come
+// from ENEMY_STATS[LEVEL]; a Weave or Regen component turns on weaving or
+// regeneration. Adding a level means a row in ENEMY_STATS, a kind here and
+// an entry in EnemySystem::Kinds.
+struct Enemy1 : Archetype<Motion, Vitals, Weapon, Status, Visual> {
+    static constexpr int LEVEL = 1;
+    static constexpr bool CHARMABLE = true;
+    using Movement = DiveMovement;
+    using Gun = SingleShotGun;
+};
+
+struct Enemy2 : Archetype<Motion, Weave, Vitals, Weapon, Status, Visual> {
+    static constexpr int LEVEL = 2;
+    static constexpr bool CHARMABLE = true;
+    using Movement = DiveMovement;
+    using Gun = SingleShotGun;
+};
+
+struct Enemy3
+    : Archetype<Motion, Weave, Vitals, Regen, Weapon, Status, Visual> {
+    static constexpr int LEVEL = 3;
+    static constexpr bool CHARMABLE = false;
+    using Movement = BossMovement;
+    using Gun = VolleyGun;
+};
+
+// Names an enemy across kinds, stale once the enemy is removed
+struct EnemyHandle {
+    int level = 0;
+    SlotIndex::Handle handle;
+};
+
+// What a tick of the EnemySystem means for the score and the spawn limits
+struct EnemyReport {
+    float bonus = 0.0f;  // kill bonus owed to the player
+    size_t killed = 0ul; // enemies destroyed or charmed
+    // Enemies per level that no longer count against the spawn limits
+    std::array<int, Constants::ENEMY_LEVEL_COUNT + 1ul> departed{};
+};
+
+// What every enemy of a level shares. Resolved through the ResourceManager
+// on the first spawn, so enemies only hold the index of their frame.
+struct EnemyPrefab {
+    static constexpr uint16_t BASE_FRAME = 0;
+    static constexpr uint16_t HIT_FRAME = 1;
+    // The death animation, played by the EffectSystem
+    static constexpr uint16_t FIRST_DOWN_FRAME = 2;
+
+    std::vector<ResourceManager::TextureRegion> frames;
+    sf::Vector2f size; // of the base frame
+    std::string downSound;
+};
+
+// All enemies, one archetype per kind. Movement, recovery, collision and
+// rendering run as systems over the component columns, instantiated per
+// kind so there is no virtual call or level switch in the loops. Shots are
+// scheduled per enemy on the Scheduler and fire into the BulletStore. An
+// enemy out of health leaves at once, its death animation handed to the
+// EffectSystem.
+//
+// Movement and the search for bullets hitting each enemy run on the
+// JobSystem in chunks of rows. Hits are buffered per chunk and applied on
+// the calling thread in row order, so the outcome matches a serial run.
+class EnemySystem {
+public:
+    EnemySystem(Scheduler &scheduler, BulletStore &bullets,
+                EffectSystem &effects, JobSystem &jobs);
+
+    EnemyHandle spawn(int level, sf::Vector2f position);
+    // o must describe an enemy of level 1 to ENEMY_LEVEL_COUNT
+    EnemyHandle spawn(const boost::json::object &o);
+
+    // A tick is removeDeparted(), move(), then collide(). move() only
+    // writes the Motion, Weave and Status of the enemies, so work that does
+    // not read them may overlap it.
+    // Removes enemies that left the screen or died
+    void removeDeparted(EnemyReport &report);
+    void move(float deltaTime);
+    // Retires enemies out of health, regenerates the others and resolves
+    // the bullets that hit them
+    void collide(float deltaTime, EnemyReport &report);
+    // Draws every enemy through batch and flushes it
+    void render(sf::RenderWindow &window, SpriteBatch &batch, float alpha);
+    void clear();
+
+    // Null once the enemy is gone
+    const Vitals *getVitals(EnemyHandle enemy) const;
+    // Position of the charmed enemy with the most health, if there is one
+    bool findStrongestCharmed(sf::Vector2f &position) const;
+    // Available enemies of level that have not been charmed
+    int countHostile(int level) const;
+    size_t size() const;
+
+    boost::json::array serialize() const;
+
+private:
+    // Kinds in level order
+    using Kinds = std::tuple<Enemy1, Enemy2, Enemy3>;
+
+    template <typename F> void forEachKind(F &&f) {
+        std::apply([&](auto &...kind) { (f(kind), ...); }, kinds);
+    }
+    template <typename F> void forEachKind(F &&f) const {
+        std::apply([&](const auto &...kind) { (f(kind), ...); }, kinds);
+    }
+
+    const EnemyPrefab &prefab(int level);
+
+    template <typename Kind>
+    EnemyHandle spawn(Kind &enemies, sf::Vector2f position);
+    // Adds an enemy to enemies from a superset of its components
+    template <typename Kind>
+    EnemyHandle insert(Kind &enemies, Motion &motion, Weave &weave,
+                       Vitals &vitals, Regen &regen, Weapon &weapon,
+                       Status &status);
+    template <typename Kind>
+    float shoot(Kind &enemies, SlotIndex::Handle handle);
+
+    template <typename Kind> void sweep(Kind &enemies, EnemyReport &report);
+    template <typename Kind> void animate(Kind &enemies, float deltaTime);
+    // A bullet overlapping the enemy in row when the search ran
+    struct Hit {
+        uint32_t row;
+        bool wasCharmed; // the layer searched depends on it
+        BulletRef bullet;
+    };
+    struct HitBuffer {
+        std::vector<Hit> hits;
+        QueryStats stats;
+    };
+
+    template <typename Kind>
+    void collideKind(Kind &enemies, EnemyReport &report);
+    template <typename Kind>
+    void findHits(Kind &enemies, size_t begin, size_t end, HitBuffer &buffer);
+    template <typename Kind>
+    void applyHit(Kind &enemies, const Hit &hit);
+    template <typename Kind>
+    void draw(Kind &enemies, SpriteBatch &batch, float alpha);
+
+    Scheduler &scheduler;
+    BulletStore &bullets;
+    EffectSystem &effects;
+    JobSystem &jobs;
+    Kinds kinds;
+    uint32_t spawnCount = 0u; // numbers the random streams of the enemies
+    std::vector<HitBuffer> hitBuffers; // one per chunk, reused every tick
+    std::array<std::optional<EnemyPrefab>, Constants::ENEMY_LEVEL_COUNT + 1ul>
+        prefabs;
+};
@@ -24,10 +24,11 @@ public:
     virtual ~Entity() = default;
 
     virtual void update(float deltaTime) {};
-    virtual void render(sf::RenderWindow &window);
-    virtual sf::FloatRect getBounds() const;
+    virtual sf::FloatRect getBounds() const = 0;
+    virtual sf::Vector2f getPosition() const = 0;
 
-    sf::Vector2f getPosition();
+    // Remember the position at the start of a tick for render interpolation
+    void storePreviousPosition();
 
     virtual boost::json::object serialize() const override;
     virtual void deserialize(const boost::json::object &o) override;
@@ -37,6 +38,30 @@ public:
     void setAvailable(bool available) { avail = available; }
 
 protected:
+    virtual void setPosition(sf::Vector2f position) = 0;
+    // alpha is the fraction of a simulation tick elapsed since the last
+    // update, used to interpolate between the previous and current position
+    sf::Vector2f getRenderPosition(float alpha) const;
+
     bool avail = true;
+
+private:
+    sf::Vector2f previousPosition;
+    bool hasPreviousPosition = false;
+};
+
+// An entity with a sprite of its own. Only for the player and the gifts, of
+// which there are few; bullets and enemies share their render data per type.
+class SpriteEntity : public Entity {
+public:
+    virtual void render(sf::RenderWindow &window, float alpha);
+    sf::FloatRect getBounds() const override;
+    sf::Vector2f getPosition() const override;
+
+protected:
+    void setPosition(sf::Vector2f position) override;
+    void drawInterpolated(sf::RenderWindow &window, sf::Sprite &target,
+                          float alpha) const;
+
     sf::Sprite sprite;
-};
\ No newline at end of file
+};
@@ -15,17 +15,20 @@
  */
 
 #pragma once
+#include "../Core/RandomUtils.hpp"
+#include "../Core/Scheduler.hpp"
 #include "../Core/Timer.hpp"
 #include "Entity.hpp"
 
-class Gift : public Entity {
+class Gift : public SpriteEntity {
 public:
     Gift() = default;
     Gift(const boost::json::object &o);
-    Gift(const std::string &name);
+    Gift(const std::string &name, RandomStream &random);
     virtual ~Gift() = default;
 
-    void update(float deltaTime) override;
+    // Schedule the disappearing warning and the expiry of this gift
+    void startCountdown(Scheduler &scheduler);
     float getRemainingTime() const;
     sf::Sprite &getSprite();
 
@@ -40,9 +43,14 @@ public:
 
 protected:
     std::string name;
-    float remainingTime;
+    float lifetime; // remaining time when lifeTimer was (re)started
+    Timer lifeTimer;
 
 private:
+    float updateDisappearing();
+
+    Scheduler::Handle disappearTask;
+    Scheduler::Handle expireTask;
     Timer disappearingTimer;
     bool disappearing = false;
     bool disappearingSound1Played = false;
@@ -51,28 +59,28 @@ private:
 
 class FullFirePower : public Gift {
 public:
-    FullFirePower();
+    FullFirePower(RandomStream &random);
 
     FullFirePower(const boost::json::object &o) : Gift(o) {}
 };
 
 class CenturyShield : public Gift {
 public:
-    CenturyShield();
+    CenturyShield(RandomStream &random);
 
     CenturyShield(const boost::json::object &o) : Gift(o) {}
 };
 
 class AllMyPeople : public Gift {
 public:
-    AllMyPeople();
+    AllMyPeople(RandomStream &random);
 
     AllMyPeople(const boost::json::object &o) : Gift(o) {}
 };
 
 class SpeedStorm : public Gift {
 public:
-    SpeedStorm();
+    SpeedStorm(RandomStream &random);
 
     SpeedStorm(const boost::json::object &o) : Gift(o) {}
 };
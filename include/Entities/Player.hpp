@@ -16,8 +16,12 @@
 
 #pragma once
 #include "../Core/Constants.hpp"
+#include "../Core/RandomUtils.hpp"
+#include "../Core/Scheduler.hpp"
+#include "../Core/SlotMap.hpp"
 #include "../Core/Timer.hpp"
-#include "Bullet.hpp"
+#include "BulletStore.hpp"
+#include "EffectSystem.hpp"
 #include "Entities/Gift.hpp"
 #include "Entity.hpp"
 #include <SFML/Graphics.hpp>
@@ -26,17 +30,31 @@
 #include <string>
 #include <vector>
 
-class Player : public Entity {
+// Directional input for one tick, filled from the keyboard by Game::run or
+// by the autopilot in headless mode
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool up = false;
+    bool down = false;
+};
+
+class Player : public SpriteEntity {
 public:
     Player();
 
     void update(float deltaTime) override;
-    void render(sf::RenderWindow &window) override;
+    void render(sf::RenderWindow &window, float alpha) override;
 
     void move(float deltaTime);
-    void updateCollisions(std::vector<std::unique_ptr<Bullet>> &bullet_pool);
-    void shoot(std::vector<std::unique_ptr<Bullet>> &bullet_pool);
+    void setInput(const PlayerInput &input);
+    void updateCollisions(BulletStore &bullet_pool, EffectSystem &effects);
+    void shoot(BulletStore &bullet_pool);
+    // Fire into bullet_pool at the current shot gap for as long as alive
+    void startShooting(Scheduler &scheduler, BulletStore &bullet_pool);
     void takeDamage(float rawDamage);
+    // Back at the starting health once it has died; keeps its gifts
+    void revive();
 
     boost::json::object serialize() const override;
     void deserialize(const boost::json::object &o) override;
@@ -52,7 +70,7 @@ public:
     bool charming = false;
     bool hasShield = false;
     float speedIncrease = 0.0f;
-    std::vector<std::unique_ptr<Gift>> gifts;
+    SlotMap<std::unique_ptr<Gift>> gifts;
 
 private:
     const std::array<std::string, 2> images = {"assets/me1.png",
@@ -61,9 +79,14 @@ private:
         "assets/me_destroy_1.png", "assets/me_destroy_2.png",
         "assets/me_destroy_3.png", "assets/me_destroy_4.png"};
 
+    // Product of the attack speed increases of all active gifts
+    float getShotMultiplier() const;
+
     float speed;
+    PlayerInput input;
+    RandomStream random{RandomStreamId::Player};
     size_t current_texture;
-    Timer lastShotTimer;
+    Scheduler::Handle shotTask;
     Timer deathTimer;
     Timer animationTimer;
     Timer recoverTimer;
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../Core/Constants.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+enum class VolleyKind : uint8_t { Cannon, Missile, Rocket };
+
+// A group of identical bullets fired together by BulletStore::fire().
+// Bullet i leaves from the shooter's origin + offset + i * step, heading
+// along direction with up to spread of random sideways jitter, at
+// speedScale + i * speedStep times the shooter's bullet speed.
+struct Volley {
+    VolleyKind kind = VolleyKind::Cannon;
+    size_t id = Constants::ENEMY_BULLET_ID;
+    int count = 1;
+    float offsetX = 0.0f, offsetY = 0.0f;
+    float stepX = 0.0f, stepY = 0.0f;
+    float directionX = 0.0f, directionY = 1.0f;
+    float spread = 0.0f;
+    float speedScale = 1.0f, speedStep = 0.0f;
+    float damageScale = 1.0f;
+    // Missiles only: the most a hostile missile turns towards its target,
+    // in units of PI radians per second. Bullet i of the volley gets
+    // tracking + i * trackingStep, so the missiles of a volley fan out.
+    float tracking = 0.0f, trackingStep = 0.0f;
+
+    constexpr Volley withCount(int n) const {
+        Volley volley = *this;
+        volley.count = n;
+        return volley;
+    }
+};
+
+// Who fires a Volley: positions, speeds and damage are relative to it
+struct Shooter {
+    sf::Vector2f origin;
+    float bulletSpeed;
+    float damage;
+    bool from_player;
+    bool charming = false;
+};
+
+// clang-format off
+namespace Volleys {
+
+// Player: twin cannons, and the spray while the shot speed is boosted
+inline constexpr Volley PLAYER_TWIN = {
+    .id = Constants::PLAYER_BULLET_ID, .count = 2,
+    .offsetX = -20.0f, .offsetY = -16.0f, .stepX = 40.0f,
+    .directionY = -1.0f,
+};
+inline constexpr Volley PLAYER_SPRAY = {
+    .id = Constants::PLAYER_SUPER_BULLET_ID, .count = 6,
+    .offsetY = -32.0f, .directionY = -1.0f, .spread = 0.4f,
+};
+
+// Enemy I and II, from below their sprite, or above it once charmed
+inline constexpr Volley ENEMY_SHOT = {
+    .offsetY = 8.0f,
+};
+inline constexpr Volley CHARMED_ENEMY_SHOT = {
+    .id = Constants::PLAYER_BULLET_ID,
+    .offsetY = -8.0f, .directionY = -1.0f,
+};
+
+// Boss, from below its sprite. The missile volleys are fired with 2 or
+// 4 missiles, one pair per rank.
+inline constexpr Volley BOSS_SPREAD = {
+    .id = Constants::ENEMY3_BULLET_ID, .count = 6,
+    .offsetY = 8.0f, .spread = 0.32f,
+};
+inline constexpr Volley BOSS_MISSILES_LEFT = {
+    .kind = VolleyKind::Missile, .id = Constants::ENEMY_MISSILE_ID,
+    .offsetX = -50.0f, .offsetY = 8.0f, .stepX = -20.0f, .stepY = -36.0f,
+    .speedScale = 0.08f, .speedStep = 0.01f, .damageScale = 4.2f,
+    .tracking = 0.4f, .trackingStep = 0.5f,
+};
+inline constexpr Volley BOSS_MISSILES_RIGHT = {
+    .kind = VolleyKind::Missile, .id = Constants::ENEMY_MISSILE_ID,
+    .offsetX = 50.0f, .offsetY = 8.0f, .stepX = 20.0f, .stepY = -36.0f,
+    .speedScale = 0.02f, .speedStep = 0.03f, .damageScale = 4.2f,
+    .tracking = 0.4f, .trackingStep = 0.5f,
+};
+inline constexpr Volley BOSS_ROCKET_LEFT = {
+    .kind = VolleyKind::Rocket, .id = Constants::ENEMY_ROCKET_ID,
+    .offsetX = -50.0f, .offsetY = 8.0f,
+    .speedScale = 0.01f, .damageScale = 1.6f,
+};
+inline constexpr Volley BOSS_ROCKET_RIGHT = {
+    .kind = VolleyKind::Rocket, .id = Constants::ENEMY_ROCKET_ID,
+    .offsetX = 50.0f, .offsetY = 8.0f,
+    .speedScale = 0.14f, .damageScale = 1.6f,
+};
+
+} // namespace Volleys
+// clang-format on
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <string_view>
+
+// Micro-benchmarks of simulation hot paths, run headless with --bench NAME
+class Benchmark {
+public:
+    // Returns false if there is no benchmark called name
+    static bool run(std::string_view name);
+
+private:
+    // Missile and Rocket updates: one interleaved list of Bullet pointers
+    // updated through virtual calls, against BulletStore's type buckets;
+    // also prints their size
+    static void bullets();
+    // Error bounds of the fast approximations in Math, and homing steering
+    // through angles against Math::steer(). Throws std::runtime_error if an
+    // error exceeds the bound Math documents.
+    static void math();
+};
@@ -17,13 +17,21 @@
 #pragma once
 #include "../Core/Constants.hpp"
 #include "../Core/ISerializable.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/RandomUtils.hpp"
+#include "../Core/Scheduler.hpp"
+#include "../Core/ScreenEffects.hpp"
+#include "../Core/SpriteBatch.hpp"
+#include "../Core/TaskGraph.hpp"
 #include "../Core/Timer.hpp"
-#include "../Entities/Bullet.hpp"
-#include "../Entities/Enemy.hpp"
+#include "../Entities/BulletStore.hpp"
+#include "../Entities/EffectSystem.hpp"
+#include "../Entities/EnemySystem.hpp"
 #include "../Entities/Player.hpp"
 #include "../Platform/save_path.h"
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -35,11 +43,44 @@
 #define PAUSE_MIN_OPTION    0
 // clang-format on
 
+// Summary of a headless run, see Game::runHeadless()
+struct SimulationStats {
+    size_t ticks = 0ul;
+    double wallSeconds = 0.0;
+    float simulatedSeconds = 0.0f;
+    size_t bullets = 0ul;
+    size_t peakBullets = 0ul;
+    size_t enemies = 0ul;
+    size_t peakEnemies = 0ul;
+    size_t gifts = 0ul;
+    size_t killed = 0ul;
+    uint64_t scheduledEvents = 0ul;
+    uint64_t droppedBullets = 0ul;
+    uint64_t collisionCandidates = 0ul;
+    uint64_t collisionHits = 0ul;
+    size_t playerDeaths = 0ul; // the player is revived to finish the run
+    uint64_t seed = 0ul;
+    size_t workers = 0ul;
+    std::vector<TaskGraph::Timing> taskTimings;
+};
+
+// An enemy waiting in the spawn queue, see Game::queueEnemy()
+struct PendingSpawn {
+    int level;
+    sf::Vector2f position;
+};
+
 class Game : public ISerializable {
 public:
     Game(sf::RenderWindow &window);
+    // Headless game: no window, no textures, no audio
+    explicit Game(const BulletPoolConfig &bulletConfig = {});
 
     void run();
+    // Drive the simulation without rendering until maxTicks ticks have run
+    // or maxSeconds of wall-clock time have passed (0 disables a limit).
+    // The player is revived whenever it dies, so the run is not cut short.
+    SimulationStats runHeadless(size_t maxTicks, double maxSeconds);
     void bringGifts();
     void spawnEnemies();
     bool isRunning();
@@ -53,11 +94,23 @@ public:
     bool terminated;
 
 private:
+    Game(sf::RenderWindow *window, const BulletPoolConfig &bulletConfig);
+
     bool update(float deltaTime);
-    void render();
+    void buildTickGraph();
+    void updateHud();
+    void render(float alpha);
     void drawGifts();
+    void addEnemy(int level, sf::Vector2f position);
+    // Waves are queued and spawned ENEMY_SPAWN_BUDGET per tick, so a boss
+    // wave does not stall a single frame
+    void queueEnemy(int level, sf::Vector2f position);
+    void drainSpawnQueue();
+    void addGift(std::unique_ptr<Gift> gift);
+    // The boss if it is still alive, null otherwise
+    const Vitals *getBoss() const;
 
-    sf::RenderWindow &window;
+    sf::RenderWindow *window;
 
     sf::Sprite backgroundSprite;
 
@@ -73,16 +126,38 @@ private:
     sf::Text saveText;
     sf::Text exitText;
 
-    Timer deltaTimer;
+    SpriteBatch spriteBatch;
+    ScreenEffects screenEffects;
+    size_t renderedFrames = 0ul;
+
+    sf::Clock frameClock;
+    float tickAccumulator = 0.0f;
+    float renderAlpha = 1.0f;
     Timer giftTimer;
     Timer spawnTimer;
     float timeElapsed = 0.0f;
 
-    std::vector<std::unique_ptr<Bullet>> bullets;
-    std::vector<std::unique_ptr<Enemy>> enemies;
+    // Declared before the entities so that it outlives their handles
+    Scheduler scheduler{Constants::SIMULATION_TICK};
+
+    JobSystem jobs;
+    BulletStore bullets;
+    EffectSystem effects;
+    EnemySystem enemies{scheduler, bullets, effects, jobs};
+    // Counts queued enemies as well as spawned ones
     std::array<int, Constants::ENEMY_LEVEL_COUNT + 1ul> enemyCount;
+    std::deque<PendingSpawn> spawnQueue;
     Player player;
-    Enemy *currentBoss = nullptr;
+    // The last boss spawned, stale once it has been removed
+    EnemyHandle currentBoss;
+    RandomStream spawnRandom{RandomStreamId::EnemySpawns};
+    RandomStream giftRandom{RandomStreamId::Gifts};
+
+    // One simulation tick, see buildTickGraph()
+    TaskGraph tickGraph;
+    float tickDelta = 0.0f;
+    sf::Vector2f hitTarget;
+    EnemyReport enemyReport;
 
     bool running = false;
     bool showingInstructions = false;
@@ -15,7 +15,6 @@
  */
 
 #pragma once
-#include "Core/Timer.hpp"
 #include "Game.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
@@ -63,7 +62,7 @@ private:
     sf::Text exitText;
 
     sf::Sprite logoSprite;
-    Timer logoClock;
+    sf::Clock logoClock;
     bool showingLogo = false;
 
     int currentOption = MENU_OPTION_START;
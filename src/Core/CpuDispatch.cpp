@@ -0,0 +1,338 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/CpuDispatch.hpp"
+#include "Core/Constants.hpp"
+#include "Core/Logging.hpp"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+#define TW_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit the instructions a function is marked for; MSVC
+// emits any intrinsic
+#if defined(TW_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TW_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TW_TARGET(isa)
+#endif
+
+namespace {
+
+// Scalar
+
+void integrateTail(float *x, float *y, float *prevX, float *prevY,
+                   const float *vx, const float *vy,
+                   std::vector<uint32_t> &culled, size_t begin, size_t count,
+                   float dt) {
+    for (size_t i = begin; i < count; i++) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        if (!(x[i] >= 0 && x[i] <= Constants::SCREEN_WIDTH && y[i] >= 0 &&
+              y[i] <= Constants::SCREEN_HEIGHT))
+            culled.push_back((uint32_t)i);
+    }
+}
+
+void integrateScalar(float *x, float *y, float *prevX, float *prevY,
+                     const float *vx, const float *vy,
+                     std::vector<uint32_t> &culled, size_t count, float dt) {
+    integrateTail(x, y, prevX, prevY, vx, vy, culled, 0, count, dt);
+}
+
+uint64_t overlapTail(const float *left, const float *top, const float *right,
+                     const float *bottom, size_t begin, size_t count,
+                     const sf::FloatRect &area) {
+    const float areaRight = area.left + area.width;
+    const float areaBottom = area.top + area.height;
+    uint64_t mask = 0;
+    for (size_t i = begin; i < count; i++)
+        if (left[i] < areaRight && area.left < right[i] &&
+            top[i] < areaBottom && area.top < bottom[i])
+            mask |= (uint64_t)1 << i;
+    return mask;
+}
+
+uint64_t overlapScalar(const float *left, const float *top, const float *right,
+                       const float *bottom, size_t count,
+                       const sf::FloatRect &area) {
+    return overlapTail(left, top, right, bottom, 0, count, area);
+}
+
+// The six vertices of a quad at the origin, in the order of the triangles
+// top-left, bottom-left, top-right and top-right, bottom-left, bottom-right
+void quadTemplate(const sf::FloatRect &texRect, sf::Color color,
+                  sf::Vertex (&quad)[6]) {
+    const float right = texRect.left + texRect.width;
+    const float bottom = texRect.top + texRect.height;
+    const sf::Vector2f corners[6] = {{texRect.left, texRect.top},
+                                     {texRect.left, bottom},
+                                     {right, texRect.top},
+                                     {right, texRect.top},
+                                     {texRect.left, bottom},
+                                     {right, bottom}};
+    for (int i = 0; i < 6; i++)
+        quad[i] = sf::Vertex({}, color, corners[i]);
+}
+
+void fillQuadsScalar(const float *x, const float *y, size_t count,
+                     sf::Vector2f halfSize, const sf::FloatRect &texRect,
+                     sf::Color color, sf::Vertex *out) {
+    sf::Vertex quad[6];
+    quadTemplate(texRect, color, quad);
+    for (size_t i = 0; i < count; i++, out += 6) {
+        const float left = x[i] - halfSize.x, right = x[i] + halfSize.x;
+        const float top = y[i] - halfSize.y, bottom = y[i] + halfSize.y;
+        std::copy(std::begin(quad), std::end(quad), out);
+        out[0].position = {left, top};
+        out[1].position = out[4].position = {left, bottom};
+        out[2].position = out[3].position = {right, top};
+        out[5].position = {right, bottom};
+    }
+}
+
+#if defined(TW_X86)
+
+// Record the slot of every lane set in outside
+inline void cull(std::vector<uint32_t> &culled, size_t base,
+                 unsigned outside) {
+    while (outside) {
+        culled.push_back((uint32_t)(base + std::countr_zero(outside)));
+        outside &= outside - 1;
+    }
+}
+
+// SSE2
+
+TW_TARGET("sse2")
+void integrateSSE2(float *x, float *y, float *prevX, float *prevY,
+                   const float *vx, const float *vy,
+                   std::vector<uint32_t> &culled, size_t count, float dt) {
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 width = _mm_set1_ps((float)Constants::SCREEN_WIDTH);
+    const __m128 height = _mm_set1_ps((float)Constants::SCREEN_HEIGHT);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        _mm_storeu_ps(prevX + i, px);
+        _mm_storeu_ps(prevY + i, py);
+        px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(vx + i), step));
+        py = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(vy + i), step));
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+
+        __m128 inside =
+            _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(px, zero),
+                                  _mm_cmple_ps(px, width)),
+                       _mm_and_ps(_mm_cmpge_ps(py, zero),
+                                  _mm_cmple_ps(py, height)));
+        cull(culled, i, ~(unsigned)_mm_movemask_ps(inside) & 0xfu);
+    }
+    integrateTail(x, y, prevX, prevY, vx, vy, culled, i, count, dt);
+}
+
+TW_TARGET("sse2")
+uint64_t overlapSSE2(const float *left, const float *top, const float *right,
+                     const float *bottom, size_t count,
+                     const sf::FloatRect &area) {
+    const __m128 areaLeft = _mm_set1_ps(area.left);
+    const __m128 areaTop = _mm_set1_ps(area.top);
+    const __m128 areaRight = _mm_set1_ps(area.left + area.width);
+    const __m128 areaBottom = _mm_set1_ps(area.top + area.height);
+    uint64_t mask = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 inside = _mm_and_ps(
+            _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(left + i), areaRight),
+                       _mm_cmplt_ps(areaLeft, _mm_loadu_ps(right + i))),
+            _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(top + i), areaBottom),
+                       _mm_cmplt_ps(areaTop, _mm_loadu_ps(bottom + i))));
+        mask |= (uint64_t)_mm_movemask_ps(inside) << i;
+    }
+    return mask | overlapTail(left, top, right, bottom, i, count, area);
+}
+
+// Every corner of a quad from two vector adds, stored a pair of floats at a
+// time
+TW_TARGET("sse2")
+void fillQuadsSSE2(const float *x, const float *y, size_t count,
+                   sf::Vector2f halfSize, const sf::FloatRect &texRect,
+                   sf::Color color, sf::Vertex *out) {
+    static_assert(sizeof(sf::Vector2f) == 2 * sizeof(float));
+    sf::Vertex quad[6];
+    quadTemplate(texRect, color, quad);
+    // (left, top, right, bottom) and (left, bottom, right, top) offsets
+    const __m128 mainDiagonal =
+        _mm_setr_ps(-halfSize.x, -halfSize.y, halfSize.x, halfSize.y);
+    const __m128 otherDiagonal =
+        _mm_setr_ps(-halfSize.x, halfSize.y, halfSize.x, -halfSize.y);
+    for (size_t i = 0; i < count; i++, out += 6) {
+        const __m128 center = _mm_setr_ps(x[i], y[i], x[i], y[i]);
+        const __m128 topLeftBottomRight = _mm_add_ps(center, mainDiagonal);
+        const __m128 bottomLeftTopRight = _mm_add_ps(center, otherDiagonal);
+        std::copy(std::begin(quad), std::end(quad), out);
+        _mm_storel_pi((__m64 *)&out[0].position, topLeftBottomRight);
+        _mm_storel_pi((__m64 *)&out[1].position, bottomLeftTopRight);
+        _mm_storeh_pi((__m64 *)&out[2].position, bottomLeftTopRight);
+        _mm_storeh_pi((__m64 *)&out[3].position, bottomLeftTopRight);
+        _mm_storel_pi((__m64 *)&out[4].position, bottomLeftTopRight);
+        _mm_storeh_pi((__m64 *)&out[5].position, topLeftBottomRight);
+    }
+}
+
+// AVX2
+
+TW_TARGET("avx2")
+void integrateAVX2(float *x, float *y, float *prevX, float *prevY,
+                   const float *vx, const float *vy,
+                   std::vector<uint32_t> &culled, size_t count, float dt) {
+    const __m256 step = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 width = _mm256_set1_ps((float)Constants::SCREEN_WIDTH);
+    const __m256 height = _mm256_set1_ps((float)Constants::SCREEN_HEIGHT);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        _mm256_storeu_ps(prevX + i, px);
+        _mm256_storeu_ps(prevY + i, py);
+        px = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(vx + i), step));
+        py = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(vy + i), step));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+
+        __m256 inside = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(px, zero, _CMP_GE_OQ),
+                          _mm256_cmp_ps(px, width, _CMP_LE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(py, zero, _CMP_GE_OQ),
+                          _mm256_cmp_ps(py, height, _CMP_LE_OQ)));
+        cull(culled, i, ~(unsigned)_mm256_movemask_ps(inside) & 0xffu);
+    }
+    integrateTail(x, y, prevX, prevY, vx, vy, culled, i, count, dt);
+}
+
+TW_TARGET("avx2")
+uint64_t overlapAVX2(const float *left, const float *top, const float *right,
+                     const float *bottom, size_t count,
+                     const sf::FloatRect &area) {
+    const __m256 areaLeft = _mm256_set1_ps(area.left);
+    const __m256 areaTop = _mm256_set1_ps(area.top);
+    const __m256 areaRight = _mm256_set1_ps(area.left + area.width);
+    const __m256 areaBottom = _mm256_set1_ps(area.top + area.height);
+    uint64_t mask = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 inside = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(left + i), areaRight,
+                                        _CMP_LT_OQ),
+                          _mm256_cmp_ps(areaLeft, _mm256_loadu_ps(right + i),
+                                        _CMP_LT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(top + i), areaBottom,
+                                        _CMP_LT_OQ),
+                          _mm256_cmp_ps(areaTop, _mm256_loadu_ps(bottom + i),
+                                        _CMP_LT_OQ)));
+        mask |= (uint64_t)_mm256_movemask_ps(inside) << i;
+    }
+    return mask | overlapTail(left, top, right, bottom, i, count, area);
+}
+
+#endif
+
+// The variant for level, or the best one below it if level has none
+template <typename Fn>
+Fn pick(const char *kernel, SimdLevel level, Fn scalar, Fn sse2, Fn avx2) {
+    const Fn variants[] = {scalar, sse2, avx2};
+    int i = (int)level;
+    while (i > 0 && !variants[i])
+        i--;
+    LOG_INFO("Kernel " << kernel << ": " << CpuDispatch::getName((SimdLevel)i));
+    return variants[i];
+}
+
+} // namespace
+
+SimdLevel CpuDispatch::level = SimdLevel::Scalar;
+CpuDispatch::IntegrateFn CpuDispatch::integrate = integrateScalar;
+CpuDispatch::OverlapFn CpuDispatch::overlap = overlapScalar;
+CpuDispatch::FillQuadsFn CpuDispatch::fillQuads = fillQuadsScalar;
+
+void CpuDispatch::init(bool forceScalar) {
+    const SimdLevel best = detect();
+    level = forceScalar ? SimdLevel::Scalar : best;
+    LOG_INFO("CPU supports " << getName(best) << ", using " << getName(level));
+#if defined(TW_X86)
+    integrate = pick<IntegrateFn>("integrate", level, integrateScalar,
+                                  integrateSSE2, integrateAVX2);
+    overlap = pick<OverlapFn>("overlap", level, overlapScalar, overlapSSE2,
+                              overlapAVX2);
+    fillQuads = pick<FillQuadsFn>("fillQuads", level, fillQuadsScalar,
+                                  fillQuadsSSE2, nullptr);
+#else
+    integrate = pick<IntegrateFn>("integrate", level, integrateScalar,
+                                  nullptr, nullptr);
+    overlap = pick<OverlapFn>("overlap", level, overlapScalar, nullptr,
+                              nullptr);
+    fillQuads = pick<FillQuadsFn>("fillQuads", level, fillQuadsScalar,
+                                  nullptr, nullptr);
+#endif
+}
+
+SimdLevel CpuDispatch::detect() {
+#if defined(TW_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+#elif defined(TW_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = info[3] & (1 << 26);
+    // AVX needs OSXSAVE and the OS saving the YMM registers as well
+    const bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+                     (_xgetbv(0) & 6) == 6;
+    if (avx && maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+            return SimdLevel::AVX2;
+    }
+    if (sse2)
+        return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+const char *CpuDispatch::getName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/JobSystem.hpp"
+#include <limits>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+// Which JobSystem the current thread works for, and its queue there
+thread_local const JobSystem *currentSystem = nullptr;
+thread_local size_t currentQueue = 0;
+
+} // namespace
+
+size_t JobSystem::workerLimit = std::numeric_limits<size_t>::max();
+
+JobSystem::JobSystem(size_t workers) {
+    queues.reserve(workers + 1);
+    for (size_t i = 0; i <= workers; i++)
+        queues.push_back(std::make_unique<Queue>());
+    threads.reserve(workers);
+    for (size_t i = 1; i <= workers; i++)
+        threads.emplace_back([this, i] { workerLoop(i); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleeping.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+size_t JobSystem::availableCpus() {
+#ifdef __linux__
+    // Honours taskset and cpuset limits, unlike hardware_concurrency()
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        return std::max(CPU_COUNT(&set), 1);
+#endif
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+size_t JobSystem::defaultWorkerCount() {
+    return std::min(availableCpus() - 1, workerLimit);
+}
+
+void JobSystem::setWorkerLimit(size_t limit) { workerLimit = limit; }
+
+void JobSystem::submit(Group &group, Job job) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    Queue &queue = *queues[queueOfThisThread()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back([this, &group, job = std::move(job)] {
+            job();
+            group.pending.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this with a worker about to sleep
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleeping.notify_one();
+}
+
+void JobSystem::wait(Group &group) {
+    const size_t home = queueOfThisThread();
+    while (!group.isDone())
+        if (!tryRunOne(home))
+            std::this_thread::yield();
+}
+
+size_t JobSystem::queueOfThisThread() const {
+    return currentSystem == this ? currentQueue : 0;
+}
+
+bool JobSystem::tryRunOne(size_t home) {
+    Job job;
+    // Newest job of our own queue first, then the oldest of the others
+    for (size_t i = 0; i < queues.size() && !job; i++) {
+        Queue &queue = *queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        if (i == 0) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+    if (!job)
+        return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    job();
+    return true;
+}
+
+void JobSystem::workerLoop(size_t home) {
+    currentSystem = this;
+    currentQueue = home;
+    for (;;) {
+        if (tryRunOne(home))
+            continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleeping.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping)
+            return;
+    }
+}
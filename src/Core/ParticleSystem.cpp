@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/ParticleSystem.hpp"
+#include "Core/Math.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float DRAG = 3.0f; // share of the speed lost per second, roughly
+
+} // namespace
+
+ParticleSystem::ParticleSystem(size_t capacity)
+    : x(capacity), y(capacity), vx(capacity), vy(capacity), age(capacity),
+      lifetime(capacity), sizes(capacity), color(capacity) {}
+
+void ParticleSystem::emit(const ParticleBurst &burst, sf::Vector2f position,
+                          sf::Vector2f velocity) {
+    const size_t fits = std::min(burst.count, x.size() - count);
+    dropped += burst.count - fits;
+    for (size_t n = 0; n < fits; n++) {
+        const size_t i = count++;
+        const float angle =
+            RandomUtils::generateInRange(random, 0.0f, 2.0f * Math::PI);
+        float sine, cosine;
+        Math::fastSinCos(angle, sine, cosine);
+        const float speed = RandomUtils::generateInRange(
+            random, burst.minSpeed, burst.maxSpeed);
+        x[i] = position.x;
+        y[i] = position.y;
+        vx[i] = velocity.x + cosine * speed;
+        vy[i] = velocity.y + sine * speed;
+        age[i] = 0.0f;
+        lifetime[i] = RandomUtils::generateInRange(random, burst.minLifetime,
+                                                   burst.maxLifetime);
+        sizes[i] = burst.size;
+        color[i] = burst.color;
+    }
+}
+
+void ParticleSystem::update(float deltaTime) {
+    const float damping = std::exp(-DRAG * deltaTime);
+    for (size_t i = 0; i < count;) {
+        age[i] += deltaTime;
+        if (age[i] >= lifetime[i]) {
+            eraseAt(i);
+            continue;
+        }
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        vx[i] *= damping;
+        vy[i] *= damping;
+        ++i;
+    }
+}
+
+void ParticleSystem::render(SpriteBatch &batch) const {
+    const sf::IntRect unit(0, 0, 1, 1);
+    for (size_t i = 0; i < count; i++) {
+        const float half = sizes[i] / 2.0f;
+        const sf::Transform transform(sizes[i], 0.f, x[i] - half, 0.f,
+                                      sizes[i], y[i] - half, 0.f, 0.f, 1.f);
+        sf::Color faded = color[i];
+        faded.a = (sf::Uint8)(faded.a * (1.0f - age[i] / lifetime[i]));
+        batch.add(nullptr, unit, transform, faded);
+    }
+}
+
+void ParticleSystem::eraseAt(size_t i) {
+    const size_t last = --count;
+    x[i] = x[last];
+    y[i] = y[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+    age[i] = age[last];
+    lifetime[i] = lifetime[last];
+    sizes[i] = sizes[last];
+    color[i] = color[last];
+}
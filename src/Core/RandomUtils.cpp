@@ -1,4 +1,48 @@
 #include "Core/RandomUtils.hpp"
+#include "Core/Logging.hpp"
+#include <random>
 
-std::random_device RandomUtils::rd;
-std::mt19937 RandomUtils::gen(rd());
+namespace {
+
+uint64_t randomSeed() {
+    std::random_device rd;
+    return ((uint64_t)rd() << 32) | rd();
+}
+
+} // namespace
+
+uint64_t RandomUtils::seed = randomSeed();
+bool RandomUtils::seedFixed = false;
+
+void RandomUtils::setSeed(uint64_t value) {
+    seed = value;
+    seedFixed = true;
+}
+
+void RandomUtils::reseed() {
+    if (seedFixed)
+        return;
+    seed = randomSeed();
+    LOG_INFO("Random seed: " << seed);
+}
+
+RandomStream::RandomStream(RandomStreamId subsystem, uint32_t entity)
+    : key{(uint32_t)RandomUtils::getSeed(),
+          (uint32_t)(RandomUtils::getSeed() >> 32)},
+      entity(entity), subsystem((uint32_t)subsystem) {}
+
+std::array<uint32_t, 4>
+RandomStream::philox(std::array<uint32_t, 4> counter) const {
+    constexpr uint64_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    constexpr uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        const uint64_t p0 = M0 * counter[0];
+        const uint64_t p1 = M1 * counter[2];
+        counter = {(uint32_t)(p1 >> 32) ^ counter[1] ^ k0, (uint32_t)p1,
+                   (uint32_t)(p0 >> 32) ^ counter[3] ^ k1, (uint32_t)p0};
+        k0 += W0;
+        k1 += W1;
+    }
+    return counter;
+}
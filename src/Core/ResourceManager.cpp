@@ -15,7 +15,9 @@
  */
 
 #include "Core/ResourceManager.hpp"
+#include "Core/Constants.hpp"
 #include "Core/Logging.hpp"
+#include <algorithm>
 #include <filesystem>
 
 sf::Font ResourceManager::gameFont;
@@ -26,6 +28,15 @@ std::unordered_map<std::string, sf::Texture> ResourceManager::textures;
 
 std::unordered_map<std::string, sf::SoundBuffer> ResourceManager::soundBuffers;
 std::vector<std::unique_ptr<sf::Sound>> ResourceManager::activeSounds;
+std::unordered_map<std::string, sf::Vector2u> ResourceManager::textureSizes;
+bool ResourceManager::headless = false;
+TextureAtlas ResourceManager::atlas{Constants::ATLAS_PAGE_SIZE};
+
+static bool isSmooth(const std::string &texturePath) {
+    return std::find(std::begin(Constants::SMOOTH_TEXTURES),
+                     std::end(Constants::SMOOTH_TEXTURES),
+                     texturePath) != std::end(Constants::SMOOTH_TEXTURES);
+}
 
 sf::Texture &ResourceManager::getTexture(const std::string &texturePath) {
     auto it = textures.find(texturePath);
@@ -39,10 +50,67 @@ sf::Texture &ResourceManager::getTexture(const std::string &texturePath) {
     } else {
         LOG_INFO("Loaded texture: " + texturePath);
     }
+    texture.setSmooth(isSmooth(texturePath));
     return texture;
 }
 
+void ResourceManager::buildAtlas(const std::string &directory) {
+    if (headless)
+        return;
+
+    std::vector<std::string> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+        if (entry.path().extension() == ".png")
+            paths.push_back(entry.path().generic_string());
+    std::sort(paths.begin(), paths.end()); // the same layout every run
+
+    atlas = TextureAtlas(std::min(Constants::ATLAS_PAGE_SIZE,
+                                  sf::Texture::getMaximumSize()));
+    for (const auto &path : paths) {
+        if (isSmooth(path))
+            continue;
+        sf::Image image;
+        if (!image.loadFromFile(path))
+            throw TextureLoadException("Failed to load texture: " + path);
+        const sf::Vector2u size = image.getSize();
+        if (size.x <= Constants::ATLAS_MAX_IMAGE_SIZE &&
+            size.y <= Constants::ATLAS_MAX_IMAGE_SIZE)
+            atlas.add(path, image);
+    }
+    atlas.build();
+    LOG_INFO("Packed " << atlas.size() << " textures into "
+                       << atlas.getPageCount() << " atlas pages");
+}
+
+ResourceManager::TextureRegion
+ResourceManager::getRegion(const std::string &texturePath) {
+    if (headless) {
+        const sf::Vector2u size = getTextureSize(texturePath);
+        return {nullptr, sf::IntRect(0, 0, (int)size.x, (int)size.y)};
+    }
+    if (const TextureAtlas::Region *region = atlas.find(texturePath))
+        return {&atlas.getPage(region->page), region->rect};
+    const sf::Texture &texture = getTexture(texturePath);
+    const sf::Vector2u size = texture.getSize();
+    return {&texture, sf::IntRect(0, 0, (int)size.x, (int)size.y)};
+}
+
 bool ResourceManager::getTextureifExists(const std::string &texturePath) {
+    if (headless) {
+        if (textureSizes.count(texturePath))
+            return true;
+        if (!std::filesystem::exists(texturePath))
+            return false;
+        try {
+            getTextureSize(texturePath);
+        } catch (const TextureLoadException &) {
+            return false;
+        }
+        return true;
+    }
+
+    if (atlas.find(texturePath))
+        return true;
     auto it = textures.find(texturePath);
     if (it != textures.end())
         return true;
@@ -60,6 +128,53 @@ bool ResourceManager::getTextureifExists(const std::string &texturePath) {
     return false;
 }
 
+sf::Vector2u ResourceManager::getTextureSize(const std::string &texturePath) {
+    if (!headless) {
+        const sf::IntRect rect = getRegion(texturePath).rect;
+        return sf::Vector2u((unsigned)rect.width, (unsigned)rect.height);
+    }
+
+    auto it = textureSizes.find(texturePath);
+    if (it != textureSizes.end())
+        return it->second;
+
+    // sf::Image decodes on the CPU, so this works without a GL context
+    sf::Image image;
+    if (!image.loadFromFile(texturePath))
+        throw TextureLoadException("Failed to load texture: " + texturePath);
+    LOG_INFO("Loaded texture size: " + texturePath);
+    return textureSizes.emplace(texturePath, image.getSize()).first->second;
+}
+
+void ResourceManager::setSpriteTexture(sf::Sprite &sprite,
+                                       const std::string &texturePath) {
+    if (!headless) {
+        const TextureRegion region = getRegion(texturePath);
+        sf::IntRect rect = region.rect;
+        // sf::Sprite::setTexture() keeps the rect of the first texture; keep
+        // its size, but within the new region so that no neighbour shows
+        if (sprite.getTexture()) {
+            const sf::IntRect &current = sprite.getTextureRect();
+            rect.width = std::min(rect.width, current.width);
+            rect.height = std::min(rect.height, current.height);
+        }
+        sprite.setTexture(*region.texture);
+        sprite.setTextureRect(rect);
+        return;
+    }
+
+    // Same rule as sf::Sprite::setTexture(): only the first texture
+    // assigned to a sprite determines its texture rect
+    if (sprite.getTextureRect() == sf::IntRect()) {
+        sf::Vector2u size = getTextureSize(texturePath);
+        sprite.setTextureRect(sf::IntRect(0, 0, (int)size.x, (int)size.y));
+    }
+}
+
+void ResourceManager::setHeadless(bool enabled) { headless = enabled; }
+
+bool ResourceManager::isHeadless() { return headless; }
+
 void ResourceManager::loadGameFont(const std::string &fontPath) {
     if (!gameFont.loadFromFile(fontPath))
         throw FontLoadException("Failed to load font: " + fontPath);
@@ -82,6 +197,9 @@ void ResourceManager::loadBackgroundMusic(const std::string &filePath) {
 }
 
 void ResourceManager::playSound(const std::string &filePath) {
+    if (headless)
+        return;
+
     auto it = soundBuffers.find(filePath);
     if (it == soundBuffers.end()) {
         sf::SoundBuffer buffer;
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/Scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+
+Scheduler::Handle &Scheduler::Handle::operator=(Handle &&other) noexcept {
+    if (this != &other) {
+        cancel();
+        scheduler = std::exchange(other.scheduler, nullptr);
+        index = other.index;
+        generation = other.generation;
+    }
+    return *this;
+}
+
+void Scheduler::Handle::cancel() {
+    if (scheduler)
+        scheduler->cancel(index, generation);
+    scheduler = nullptr;
+}
+
+bool Scheduler::Handle::isPending() const {
+    return scheduler && scheduler->isCurrent(index, generation);
+}
+
+Scheduler::Scheduler(float tickSeconds) : ticksPerSecond(1.0f / tickSeconds) {
+    buckets.fill(NIL);
+}
+
+Scheduler::Handle Scheduler::schedule(float delaySeconds, Callback callback) {
+    uint32_t index;
+    if (freeList.empty()) {
+        index = (uint32_t)tasks.size();
+        tasks.emplace_back();
+    } else {
+        index = freeList.back();
+        freeList.pop_back();
+    }
+
+    Task &task = tasks[index];
+    task.callback = std::move(callback);
+    task.expiry = currentTick + toTicks(delaySeconds);
+    task.live = true;
+    link(index);
+    pendingCount++;
+    return Handle(this, index, task.generation);
+}
+
+void Scheduler::advance() {
+    currentTick++;
+
+    // When a wheel wraps around, the next slot of the wheel above is spread
+    // over the finer wheels. Cascade from the coarsest wheel down so that
+    // tasks moved into a finer slot that is also due get cascaded again.
+    unsigned top = 0;
+    while (top + 1 < LEVELS &&
+           (currentTick & ((1ull << ((top + 1) * SLOT_BITS)) - 1)) == 0)
+        top++;
+    for (unsigned level = top; level > 0; level--)
+        cascade(level);
+
+    fire();
+}
+
+uint64_t Scheduler::toTicks(float seconds) const {
+    // Small tolerance so that e.g. 0.2s at 120Hz is 24 ticks, not 25
+    double ticks = std::ceil((double)seconds * ticksPerSecond - 1e-3);
+    if (ticks < 1.0)
+        return 1;
+    return std::min((uint64_t)ticks, MAX_DELAY_TICKS);
+}
+
+bool Scheduler::isCurrent(uint32_t index, uint32_t generation) const {
+    return index < tasks.size() && tasks[index].live &&
+           tasks[index].generation == generation;
+}
+
+void Scheduler::cancel(uint32_t index, uint32_t generation) {
+    if (!isCurrent(index, generation))
+        return;
+    if (tasks[index].bucket != UNLINKED)
+        unlink(index);
+    release(index);
+}
+
+void Scheduler::link(uint32_t index) {
+    Task &task = tasks[index];
+    uint64_t delta = task.expiry > currentTick ? task.expiry - currentTick : 0;
+
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (1ull << ((level + 1) * SLOT_BITS)))
+        level++;
+    unsigned slot = (task.expiry >> (level * SLOT_BITS)) & (SLOTS - 1);
+
+    task.bucket = (uint16_t)(level * SLOTS + slot);
+    task.prev = NIL;
+    task.next = buckets[task.bucket];
+    if (task.next != NIL)
+        tasks[task.next].prev = index;
+    buckets[task.bucket] = index;
+}
+
+void Scheduler::unlink(uint32_t index) {
+    Task &task = tasks[index];
+    if (task.prev != NIL)
+        tasks[task.prev].next = task.next;
+    else
+        buckets[task.bucket] = task.next;
+    if (task.next != NIL)
+        tasks[task.next].prev = task.prev;
+    task.prev = task.next = NIL;
+    task.bucket = UNLINKED;
+}
+
+void Scheduler::release(uint32_t index) {
+    Task &task = tasks[index];
+    task.callback = nullptr;
+    task.live = false;
+    task.generation++;
+    freeList.push_back(index);
+    pendingCount--;
+}
+
+void Scheduler::cascade(unsigned level) {
+    unsigned slot = (currentTick >> (level * SLOT_BITS)) & (SLOTS - 1);
+    uint32_t index = std::exchange(buckets[level * SLOTS + slot], NIL);
+    while (index != NIL) {
+        uint32_t next = tasks[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void Scheduler::fire() {
+    // Detach the due slot first: callbacks may schedule or cancel tasks
+    uint32_t index = std::exchange(buckets[currentTick & (SLOTS - 1)], NIL);
+    due.clear();
+    while (index != NIL) {
+        Task &task = tasks[index];
+        due.emplace_back(index, task.generation);
+        index = task.next;
+        task.prev = task.next = NIL;
+        task.bucket = UNLINKED;
+    }
+
+    for (auto [dueIndex, generation] : due) {
+        if (!isCurrent(dueIndex, generation))
+            continue;
+
+        // The callback may grow the task table, so run it from a local
+        Callback callback = std::move(tasks[dueIndex].callback);
+        float next = callback();
+        firedCount++;
+
+        if (!isCurrent(dueIndex, generation))
+            continue; // cancelled from inside its own callback
+        if (next > 0.0f) {
+            tasks[dueIndex].callback = std::move(callback);
+            tasks[dueIndex].expiry = currentTick + toTicks(next);
+            link(dueIndex);
+        } else {
+            release(dueIndex);
+        }
+    }
+}
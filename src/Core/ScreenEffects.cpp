@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/ScreenEffects.hpp"
+#include "Core/Constants.hpp"
+#include <algorithm>
+
+float ScreenEffects::fade(float progress) {
+    // Quadratic ease out: bright at the blast, quickly gone
+    const float left = 1.0f - std::clamp(progress, 0.0f, 1.0f);
+    return left * left;
+}
+
+void ScreenEffects::flash(sf::Color color, float elapsed) {
+    stats.requests++;
+    const sf::Uint8 alpha =
+        (sf::Uint8)(color.a * fade(elapsed / FLASH_DURATION));
+    for (sf::Color &merged : flashes) {
+        if (merged.r == color.r && merged.g == color.g && merged.b == color.b) {
+            merged.a = std::max(merged.a, alpha);
+            return;
+        }
+    }
+    flashes.emplace_back(color.r, color.g, color.b, alpha);
+}
+
+void ScreenEffects::overlay(const ResourceManager::TextureRegion &region) {
+    stats.requests++;
+    for (const auto &image : images)
+        if (image.texture == region.texture && image.rect == region.rect)
+            return;
+    images.push_back(region);
+}
+
+void ScreenEffects::draw(sf::RenderTarget &target) {
+    sf::RectangleShape fill(
+        sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
+    for (const sf::Color &color : flashes) {
+        if (color.a == 0)
+            continue;
+        fill.setFillColor(color);
+        target.draw(fill);
+        stats.layers++;
+    }
+    for (const auto &image : images) {
+        target.draw(sf::Sprite(*image.texture, image.rect));
+        stats.layers++;
+    }
+    flashes.clear();
+    images.clear();
+}
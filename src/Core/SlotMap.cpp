@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/SlotMap.hpp"
+
+SlotIndex::Handle SlotIndex::insert() {
+    uint32_t slot;
+    if (freeHead != NIL) {
+        slot = freeHead;
+        freeHead = slots[slot].dense;
+    } else {
+        slot = (uint32_t)slots.size();
+        slots.push_back({NIL, 0});
+    }
+    slots[slot].dense = (uint32_t)denseToSlot.size();
+    denseToSlot.push_back(slot);
+    return {slot, slots[slot].generation};
+}
+
+void SlotIndex::eraseAt(size_t denseIndex) {
+    uint32_t slot = denseToSlot[denseIndex];
+    denseToSlot[denseIndex] = denseToSlot.back();
+    slots[denseToSlot[denseIndex]].dense = (uint32_t)denseIndex;
+    denseToSlot.pop_back();
+
+    slots[slot].generation++;
+    slots[slot].dense = freeHead;
+    freeHead = slot;
+}
+
+SlotIndex::Handle SlotIndex::handleAt(size_t denseIndex) const {
+    uint32_t slot = denseToSlot[denseIndex];
+    return {slot, slots[slot].generation};
+}
+
+void SlotIndex::reserve(size_t capacity) {
+    denseToSlot.reserve(capacity);
+    slots.reserve(capacity);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+    : cellSize(cellSize), columns((int)std::ceil(width / cellSize)),
+      rows((int)std::ceil(height / cellSize)),
+      cellStart((size_t)columns * rows + 1ul, 0u) {}
+
+void SpatialGrid::clear() {
+    ids.clear();
+    boxes.clear();
+}
+
+void SpatialGrid::insert(uint32_t id, const sf::FloatRect &bounds) {
+    ids.push_back(id);
+    boxes.push_back(bounds);
+}
+
+void SpatialGrid::build() {
+    spans.resize(boxes.size());
+    for (size_t item = 0; item < boxes.size(); item++)
+        spans[item] = cellRange(boxes[item]);
+
+    // Count the items per cell, turn the counts into offsets, then fill
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+    for (const CellRange &span : spans)
+        for (int y = span.top; y <= span.bottom; y++)
+            for (int x = span.left; x <= span.right; x++)
+                cellStart[(size_t)y * columns + x + 1]++;
+    for (size_t cell = 1; cell < cellStart.size(); cell++)
+        cellStart[cell] += cellStart[cell - 1];
+
+    cellItems.resize(cellStart.back());
+    itemLeft.resize(cellItems.size());
+    itemTop.resize(cellItems.size());
+    itemRight.resize(cellItems.size());
+    itemBottom.resize(cellItems.size());
+    cursors.assign(cellStart.begin(), cellStart.end() - 1);
+    for (uint32_t item = 0; item < spans.size(); item++) {
+        const CellRange &span = spans[item];
+        const sf::FloatRect &box = boxes[item];
+        for (int y = span.top; y <= span.bottom; y++) {
+            for (int x = span.left; x <= span.right; x++) {
+                const uint32_t i = cursors[(size_t)y * columns + x]++;
+                cellItems[i] = item;
+                itemLeft[i] = box.left;
+                itemTop[i] = box.top;
+                itemRight[i] = box.left + box.width;
+                itemBottom[i] = box.top + box.height;
+            }
+        }
+    }
+}
+
+SpatialGrid::CellRange
+SpatialGrid::cellRange(const sf::FloatRect &bounds) const {
+    auto column = [this](float x) {
+        return std::clamp((int)std::floor(x / cellSize), 0, columns - 1);
+    };
+    auto row = [this](float y) {
+        return std::clamp((int)std::floor(y / cellSize), 0, rows - 1);
+    };
+    return {column(bounds.left), row(bounds.top),
+            column(bounds.left + bounds.width),
+            row(bounds.top + bounds.height)};
+}
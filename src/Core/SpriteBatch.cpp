@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/SpriteBatch.hpp"
+#include "Core/CpuDispatch.hpp"
+#include <cmath>
+
+void SpriteBatch::add(const sf::Sprite &sprite) {
+    add(sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(),
+        sprite.getColor());
+}
+
+void SpriteBatch::add(const sf::Texture *texture, const sf::IntRect &rect,
+                      const sf::Transform &transform, sf::Color color) {
+    // The same quad sf::Sprite builds for itself
+    const float width = (float)std::abs(rect.width);
+    const float height = (float)std::abs(rect.height);
+    const float left = (float)rect.left, top = (float)rect.top;
+    const float right = left + rect.width, bottom = top + rect.height;
+
+    const sf::Vector2f topLeft = transform.transformPoint({0.0f, 0.0f});
+    const sf::Vector2f bottomLeft = transform.transformPoint({0.0f, height});
+    const sf::Vector2f topRight = transform.transformPoint({width, 0.0f});
+    const sf::Vector2f bottomRight = transform.transformPoint({width, height});
+
+    std::vector<sf::Vertex> &vertices = verticesOf(texture);
+    vertices.emplace_back(topLeft, color, sf::Vector2f(left, top));
+    vertices.emplace_back(bottomLeft, color, sf::Vector2f(left, bottom));
+    vertices.emplace_back(topRight, color, sf::Vector2f(right, top));
+    vertices.emplace_back(topRight, color, sf::Vector2f(right, top));
+    vertices.emplace_back(bottomLeft, color, sf::Vector2f(left, bottom));
+    vertices.emplace_back(bottomRight, color, sf::Vector2f(right, bottom));
+    stats.sprites++;
+}
+
+void SpriteBatch::addQuads(const sf::Texture *texture,
+                           const sf::IntRect &textureRect,
+                           sf::Vector2f halfSize, const float *x,
+                           const float *y, size_t count, sf::Color color) {
+    if (count == 0ul)
+        return;
+    std::vector<sf::Vertex> &vertices = verticesOf(texture);
+    const size_t first = vertices.size();
+    vertices.resize(first + count * 6ul);
+    CpuDispatch::fillQuads(x, y, count, halfSize, sf::FloatRect(textureRect),
+                           color, &vertices[first]);
+    stats.sprites += count;
+}
+
+void SpriteBatch::flush(sf::RenderTarget &target) {
+    for (size_t i = 0; i < batchCount; i++) {
+        Batch &batch = batches[i];
+        if (batch.vertices.empty())
+            continue;
+        target.draw(batch.vertices.data(), batch.vertices.size(),
+                    sf::Triangles, sf::RenderStates(batch.texture));
+        batch.vertices.clear();
+        stats.drawCalls++;
+    }
+    batchCount = 0ul;
+}
+
+std::vector<sf::Vertex> &SpriteBatch::verticesOf(const sf::Texture *texture) {
+    for (size_t i = 0; i < batchCount; i++)
+        if (batches[i].texture == texture)
+            return batches[i].vertices;
+    // Reuse the storage of a batch from an earlier frame
+    if (batchCount == batches.size())
+        batches.push_back({texture, {}});
+    batches[batchCount].texture = texture;
+    return batches[batchCount++].vertices;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/TaskGraph.hpp"
+#include <chrono>
+#include <stdexcept>
+
+TaskGraph::TaskId TaskGraph::add(std::string name, std::function<void()> work,
+                                 std::initializer_list<TaskId> after) {
+    const TaskId id = tasks.size();
+    for (TaskId dependency : after) {
+        if (dependency >= id)
+            throw std::invalid_argument("Task " + name +
+                                        " waits for an unknown task");
+        tasks[dependency].dependents.push_back(id);
+    }
+    Task &task = tasks.emplace_back();
+    task.name = std::move(name);
+    task.work = std::move(work);
+    task.dependencies = after.size();
+    return id;
+}
+
+void TaskGraph::run(JobSystem &jobs) {
+    for (Task &task : tasks)
+        task.waiting.store(task.dependencies, std::memory_order_relaxed);
+
+    JobSystem::Group group;
+    for (TaskId id = 0; id < tasks.size(); id++)
+        if (tasks[id].dependencies == 0)
+            launch(jobs, group, id);
+    jobs.wait(group);
+}
+
+void TaskGraph::launch(JobSystem &jobs, JobSystem::Group &group, TaskId id) {
+    jobs.submit(group, [this, &jobs, &group, id] {
+        using clock = std::chrono::steady_clock;
+        Task &task = tasks[id];
+        const clock::time_point start = clock::now();
+        task.work();
+        task.seconds +=
+            std::chrono::duration<double>(clock::now() - start).count();
+        task.runs++;
+
+        for (TaskId dependent : task.dependents)
+            if (tasks[dependent].waiting.fetch_sub(
+                    1, std::memory_order_acq_rel) == 1)
+                launch(jobs, group, dependent);
+    });
+}
+
+std::vector<TaskGraph::Timing> TaskGraph::getTimings() const {
+    std::vector<Timing> timings;
+    timings.reserve(tasks.size());
+    for (const Task &task : tasks)
+        timings.push_back({task.name, task.seconds, task.runs});
+    return timings;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Core/TextureAtlas.hpp"
+#include "Core/ResourceManager.hpp"
+#include <algorithm>
+
+TextureAtlas::TextureAtlas(unsigned pageSize) : pageSize(pageSize) {}
+
+bool TextureAtlas::add(const std::string &name, const sf::Image &image) {
+    const sf::Vector2u size = image.getSize();
+    if (size.x + PADDING > pageSize || size.y + PADDING > pageSize)
+        return false;
+    pending.push_back({name, image});
+    return true;
+}
+
+void TextureAtlas::build() {
+    // Shelf packing: tallest images first, left to right along a shelf as
+    // tall as its first image, then a new shelf below it, then a new page
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const Pending &a, const Pending &b) {
+                         return a.image.getSize().y > b.image.getSize().y;
+                     });
+    std::vector<unsigned> pageHeights;
+    unsigned x = 0u, y = 0u, shelfHeight = 0u;
+    for (const Pending &image : pending) {
+        const sf::Vector2u size = image.image.getSize();
+        if (x + size.x + PADDING > pageSize) {
+            y += shelfHeight;
+            x = shelfHeight = 0u;
+        }
+        if (pageHeights.empty() || y + size.y + PADDING > pageSize) {
+            pageHeights.push_back(0u);
+            x = y = shelfHeight = 0u;
+        }
+        regions[image.name] = {pageHeights.size() - 1ul,
+                               sf::IntRect((int)(x + PADDING),
+                                           (int)(y + PADDING), (int)size.x,
+                                           (int)size.y)};
+        x += size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, size.y + PADDING);
+        // Pages are cut to the shelves in use
+        pageHeights.back() = y + shelfHeight;
+    }
+
+    std::vector<sf::Image> images(pageHeights.size());
+    for (size_t i = 0; i < images.size(); i++)
+        images[i].create(pageSize, pageHeights[i], sf::Color::Transparent);
+    for (const Pending &image : pending) {
+        const Region &region = regions.at(image.name);
+        images[region.page].copy(image.image, (unsigned)region.rect.left,
+                                 (unsigned)region.rect.top);
+    }
+    pending.clear();
+
+    pages.clear();
+    for (const sf::Image &image : images)
+        if (!pages.emplace_back().loadFromImage(image))
+            throw TextureLoadException("Failed to create an atlas page");
+}
+
+const TextureAtlas::Region *TextureAtlas::find(const std::string &name) const {
+    auto it = regions.find(name);
+    return it != regions.end() ? &it->second : nullptr;
+}
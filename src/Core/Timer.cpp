@@ -15,23 +15,20 @@
  */
 
 #include "Core/Timer.hpp"
+#include "Core/GameClock.hpp"
 
-Timer::Timer() : offset(0.0f) { clock.restart(); }
+Timer::Timer() : start(GameClock::now()) {}
 
-void Timer::restart() {
-    offset = 0.0f;
-    clock.restart();
-}
+void Timer::restart() { start = GameClock::now(); }
 
 float Timer::getElapsedTime() const {
-    return clock.getElapsedTime().asSeconds() + offset;
+    return (float)(GameClock::now() - start);
 }
 
 void Timer::setElapsedTime(float seconds) {
-    offset = seconds;
-    clock.restart();
+    start = GameClock::now() - seconds;
 }
 
 bool Timer::hasElapsed(float seconds) const {
     return getElapsedTime() >= seconds;
-}
\ No newline at end of file
+}
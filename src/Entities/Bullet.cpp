@@ -19,42 +19,84 @@
 #include "Core/Math.hpp"
 #include "Core/ResourceManager.hpp"
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <optional>
+
+namespace {
+
+// Shared by every bullet showing the image, resolved by the first one
+std::array<std::optional<BulletFrame>, std::size(Bullet::bullets_path)> frames;
+
+} // namespace
 
 Bullet::Bullet(sf::Vector2f position, sf::Vector2f direction, size_t id,
                bool from_player, float speed, float damage)
     : from_player(from_player), damage(damage), damageRate(0.0f),
-      exploding(false), speed(speed), id(id) {
+      position(position), speed(speed), id(id) {
     avail = true;
-    size_t bullets_path_size = sizeof(bullets_path) / sizeof(*bullets_path);
-    id = std::min(id, bullets_path_size - 1);
-    sprite.setTexture(ResourceManager::getTexture(bullets_path[id]));
-    sprite.setPosition(position);
+    setFrame(id);
     this->direction = Math::normalize(direction);
     timer.restart();
 }
 
+void Bullet::setFrame(size_t id) {
+    id = std::min(id, std::size(bullets_path) - 1);
+    std::optional<BulletFrame> &shared = frames[id];
+    if (!shared) {
+        const ResourceManager::TextureRegion region =
+            ResourceManager::getRegion(bullets_path[id]);
+        const sf::Vector2f size((float)region.rect.width,
+                                (float)region.rect.height);
+        shared = BulletFrame{region, size, {size.x / 2, size.y}};
+    }
+    frame = &*shared;
+}
+
 void Bullet::updateRotation() {
-    float angle = Math::vectorToAngle(direction) * Math::RAD_TO_DEG + 90.0f;
-    sprite.setRotation(angle);
+    float angle =
+        Math::fastAtan2(direction.y, direction.x) * Math::RAD_TO_DEG + 90.0f;
+    rotation = std::fmod(angle, 360.0f);
+    if (rotation < 0.0f)
+        rotation += 360.0f;
+}
+
+sf::Transform Bullet::getTransform(sf::Vector2f position) const {
+    // The arithmetic of sf::Transformable, so that bounds and pixels match
+    // those of a sprite
+    const float angle = -rotation * 3.141592654f / 180.f;
+    const float cosine = std::cos(angle), sine = std::sin(angle);
+    const sf::Vector2f origin = frame->origin;
+    return sf::Transform(
+        cosine, sine, -origin.x * cosine - origin.y * sine + position.x,
+        -sine, cosine, origin.x * sine - origin.y * cosine + position.y, 0.f,
+        0.f, 1.f);
+}
+
+sf::FloatRect Bullet::getBounds() const {
+    return getTransform(position).transformRect(
+        sf::FloatRect(sf::Vector2f(), frame->size));
 }
 
 void Bullet::update(float deltaTime, sf::Vector2f hitTarget) {
     if (!avail)
         return;
 
-    sprite.move(direction * speed * deltaTime);
+    position += direction * speed * deltaTime;
 
-    auto [x, y] = sprite.getPosition();
+    auto [x, y] = position;
     avail = (x >= 0 && x <= Constants::SCREEN_WIDTH && y >= 0 &&
              y <= Constants::SCREEN_HEIGHT);
 }
 
-void Bullet::render(sf::RenderWindow &window) {
+void Bullet::render(SpriteBatch &batch, float alpha) const {
     if (avail)
-        window.draw(sprite);
+        batch.add(frame->region.texture, frame->region.rect,
+                  getTransform(getRenderPosition(alpha)));
 }
 
-void Bullet::explode() {}
+void Bullet::explode(EffectSystem &effects) {}
 
 void Bullet::explodeSoundOnly() {}
 
@@ -64,7 +106,7 @@ boost::json::object Bullet::serialize() const {
     o["damage"] = damage;
     o["damageRate"] = damageRate;
     o["time"] = timer.getElapsedTime();
-    o["avail"] = avail && !exploding;
+    o["avail"] = avail;
     o["direction"] = {{"x", direction.x}, {"y", direction.y}};
     o["speed"] = speed;
     o["id"] = id;
@@ -86,33 +128,6 @@ void Bullet::deserialize(const boost::json::object &o) {
     id = (size_t)o.at("id").as_int64();
 }
 
-// Cannon
-
-Cannon::Cannon(const boost::json::object &o) {
-    deserialize(o);
-    sprite.setTexture(ResourceManager::getTexture(bullets_path[id]));
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height / 2);
-}
-
-Cannon::Cannon(sf::Vector2f position, sf::Vector2f direction, size_t id,
-               bool from_player, float speed, float damage, bool charming)
-    : Bullet(position, direction, id, from_player, speed, damage) {
-    this->charming = charming;
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height / 2);
-}
-
-boost::json::object Cannon::serialize() const {
-    boost::json::object o = Bullet::serialize();
-    o["type"] = "Cannon";
-    return o;
-}
-
-void Cannon::deserialize(const boost::json::object &o) {
-    Bullet::deserialize(o);
-}
-
 // Missile
 
 Missile::Missile(const boost::json::object &o) {
@@ -120,13 +135,7 @@ Missile::Missile(const boost::json::object &o) {
     if (from_player)
         this->tracking = 0.0f;
 
-    sprite.setTexture(ResourceManager::getTexture(bullets_path[id]));
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height);
-
-    whiteFlash.setSize(
-        sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
-    whiteFlash.setFillColor(sf::Color(255, 255, 255, 220));
+    setFrame(id);
 
     if (id == Constants::ENEMY_MISSILE_ID)
         updateRotation();
@@ -140,13 +149,6 @@ Missile::Missile(sf::Vector2f position, sf::Vector2f direction, size_t id,
     if (from_player)
         this->tracking = 0.0f;
 
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height);
-
-    whiteFlash.setSize(
-        sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
-    whiteFlash.setFillColor(sf::Color(255, 255, 255, 220));
-
     if (id == Constants::ENEMY_MISSILE_ID)
         updateRotation();
 }
@@ -161,19 +163,9 @@ void Missile::update(float deltaTime, sf::Vector2f hitTarget) {
     if (tracking > 0.0f) {
         speed += deltaTime * 100.0f;
         tracking += deltaTime * 0.00002f;
-        sf::Vector2f targetDir = hitTarget - sprite.getPosition();
-        targetDir = Math::normalize(targetDir);
-
-        float currentAngle = Math::vectorToAngle(direction);
-        float targetAngle = Math::vectorToAngle(targetDir);
-        float angleDiff = Math::normalizeAngle(targetAngle - currentAngle);
-
-        float maxTurn = tracking * Math::PI * deltaTime;
-        if (std::abs(angleDiff) > maxTurn)
-            angleDiff = (angleDiff > 0) ? maxTurn : -maxTurn;
-
-        float newAngle = currentAngle + angleDiff;
-        direction = Math::angleToVector(newAngle);
+        const Vec2 targetDir = Math::fastNormalize(hitTarget - position);
+        direction = Math::steer(direction, targetDir,
+                                tracking * Math::PI * deltaTime);
 
         updateRotation();
         if (timer.hasElapsed(4.2f))
@@ -182,33 +174,16 @@ void Missile::update(float deltaTime, sf::Vector2f hitTarget) {
         speed += deltaTime * 220.0f;
     }
 
-    sprite.move(direction * speed * deltaTime);
+    position += direction * speed * deltaTime;
 
-    auto [x, y] = sprite.getPosition();
+    auto [x, y] = position;
     avail = (x >= 0 && x <= Constants::SCREEN_WIDTH && y >= 0 &&
              y <= Constants::SCREEN_HEIGHT);
 }
 
-void Missile::render(sf::RenderWindow &window) {
-    if (exploding) {
-        avail = false;
-        if (explodeTimer.hasElapsed(0.6f)) {
-            exploding = false;
-        } else {
-            if (!explodeTimer.hasElapsed(0.3f))
-                window.draw(whiteFlash);
-            window.draw(explodeSprite);
-        }
-    }
-    if (avail)
-        window.draw(sprite);
-}
-
-void Missile::explode() {
+void Missile::explode(EffectSystem &effects) {
     explodeSoundOnly();
-    explodeSprite.setTexture(ResourceManager::getTexture("assets/explode.png"));
-    exploding = true;
-    explodeTimer.restart();
+    effects.blast(BlastKind::Missile, position);
 }
 
 void Missile::explodeSoundOnly() {
@@ -231,14 +206,7 @@ void Missile::deserialize(const boost::json::object &o) {
 
 Rocket::Rocket(const boost::json::object &o) {
     deserialize(o);
-    sprite.setTexture(ResourceManager::getTexture(bullets_path[id]));
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height);
-
-    redFlash.setSize(
-        sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
-    redFlash.setFillColor(sf::Color(255, 69, 1, 128));
-
+    setFrame(id);
     updateRotation();
 }
 
@@ -251,13 +219,6 @@ Rocket::Rocket(sf::Vector2f position, sf::Vector2f direction, size_t id,
     if (from_player)
         this->tracking = 0.0f;
 
-    sprite.setOrigin(sprite.getLocalBounds().width / 2,
-                     sprite.getLocalBounds().height);
-
-    redFlash.setSize(
-        sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
-    redFlash.setFillColor(sf::Color(255, 69, 1, 128));
-
     updateRotation();
 }
 
@@ -277,53 +238,25 @@ void Rocket::update(float deltaTime, sf::Vector2f hitTarget) {
         damageRate = Constants::ROCKET_DAMAGE_RATE;
 
     if (tracking > 0.0f) {
-        sf::Vector2f targetDir = hitTarget - sprite.getPosition();
-        targetDir = Math::normalize(targetDir);
-
-        float currentAngle = Math::vectorToAngle(direction);
-        float targetAngle = Math::vectorToAngle(targetDir);
-        float angleDiff = Math::normalizeAngle(targetAngle - currentAngle);
-
-        float maxTurn = tracking * Math::PI * deltaTime;
-        if (std::abs(angleDiff) > maxTurn)
-            angleDiff = (angleDiff > 0) ? maxTurn : -maxTurn;
-
-        float newAngle = currentAngle + angleDiff;
-        direction = Math::angleToVector(newAngle);
+        const Vec2 targetDir = Math::fastNormalize(hitTarget - position);
+        direction = Math::steer(direction, targetDir,
+                                tracking * Math::PI * deltaTime);
 
         updateRotation();
     }
 
     speed += deltaTime * 540.0f;
 
-    sprite.move(direction * speed * deltaTime);
+    position += direction * speed * deltaTime;
 
-    auto [x, y] = sprite.getPosition();
+    auto [x, y] = position;
     avail = (x >= 0 && x <= Constants::SCREEN_WIDTH && y >= 0 &&
              y <= Constants::SCREEN_HEIGHT);
 }
 
-void Rocket::render(sf::RenderWindow &window) {
-    if (exploding) {
-        avail = false;
-        if (explodeTimer.hasElapsed(0.6f)) {
-            exploding = false;
-        } else {
-            if (!explodeTimer.hasElapsed(0.3f))
-                window.draw(redFlash);
-            window.draw(explodeSprite);
-        }
-    }
-    if (avail)
-        window.draw(sprite);
-}
-
-void Rocket::explode() {
+void Rocket::explode(EffectSystem &effects) {
     explodeSoundOnly();
-    explodeSprite.setTexture(
-        ResourceManager::getTexture("assets/explode2.png"));
-    exploding = true;
-    explodeTimer.restart();
+    effects.blast(BlastKind::Rocket, position);
 }
 
 void Rocket::explodeSoundOnly() {
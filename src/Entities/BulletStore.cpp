@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Entities/BulletStore.hpp"
+#include "Core/Constants.hpp"
+#include "Core/Math.hpp"
+#include "Core/RandomUtils.hpp"
+
+BulletStore::Layer::Layer(bool from_player, const BulletPoolConfig &config)
+    : cannons(from_player, config.capacity),
+      grid(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT,
+           Constants::COLLISION_CELL_SIZE) {
+    missiles.reserve(config.objectCapacity);
+    rockets.reserve(config.objectCapacity);
+}
+
+BulletStore::BulletStore(const BulletPoolConfig &config)
+    : config(config), objectPool(config.objectCapacity) {
+    layers.reserve(CollisionLayers::BULLET_LAYER_COUNT);
+    for (size_t i = 0; i < CollisionLayers::BULLET_LAYER_COUNT; i++)
+        layers.emplace_back((BulletLayer)i != BulletLayer::Hostile, config);
+}
+
+BulletStore::Layer &BulletStore::layerFor(bool from_player, bool charming) {
+    return layers[(size_t)CollisionLayers::layerOf(from_player, charming)];
+}
+
+void BulletStore::fire(const Volley &volley, const Shooter &shooter,
+                       RandomStream &random) {
+    const sf::Vector2f origin =
+        shooter.origin + sf::Vector2f(volley.offsetX, volley.offsetY);
+    const sf::Vector2f step(volley.stepX, volley.stepY);
+    const float damage = shooter.damage * volley.damageScale;
+
+    const BulletLayer layer =
+        CollisionLayers::layerOf(shooter.from_player, shooter.charming);
+    BulletSystem &cannons = layers[(size_t)layer].cannons;
+    size_t live = volley.kind == VolleyKind::Cannon ? getLiveCannonCount() : 0;
+
+    for (int i = 0; i < volley.count; i++) {
+        const sf::Vector2f position = origin + step * (float)i;
+        sf::Vector2f direction(volley.directionX, volley.directionY);
+        if (volley.spread > 0.0f) {
+            direction.x += RandomUtils::generateInRange(random, -volley.spread,
+                                                        volley.spread);
+            direction = Math::normalize(direction);
+        }
+        const float speed =
+            shooter.bulletSpeed * (volley.speedScale + i * volley.speedStep);
+
+        switch (volley.kind) {
+            case VolleyKind::Cannon:
+                if (makeRoom(layer, live))
+                    cannons.spawn(position, direction, volley.id, speed,
+                                  damage);
+                else
+                    dropped++;
+                break;
+            case VolleyKind::Missile:
+                add<Missile>(position, direction, volley.id,
+                             shooter.from_player, speed, damage,
+                             volley.tracking + i * volley.trackingStep);
+                break;
+            case VolleyKind::Rocket:
+                add<Rocket>(position, direction, volley.id,
+                            shooter.from_player, speed, damage);
+                break;
+        }
+    }
+}
+
+void BulletStore::addCannon(const boost::json::object &o) {
+    const BulletLayer layer =
+        CollisionLayers::layerOf(o.at("from_player").as_bool(), false);
+    size_t live = getLiveCannonCount();
+    if (makeRoom(layer, live))
+        layers[(size_t)layer].cannons.spawn(o);
+    else
+        dropped++;
+}
+
+size_t BulletStore::getLiveCannonCount() const {
+    size_t live = 0ul;
+    for (const auto &layer : layers)
+        live += layer.cannons.getLiveCount();
+    return live;
+}
+
+bool BulletStore::makeRoom(BulletLayer layer, size_t &live) {
+    if (config.policy == OverflowPolicy::RefuseHostileFirst &&
+        layer == BulletLayer::Hostile &&
+        live >= config.capacity * Constants::BULLET_HOSTILE_SHARE)
+        return false;
+    if (live < config.capacity) {
+        live++;
+        return true;
+    }
+    if (config.policy == OverflowPolicy::DropOldest &&
+        layers[(size_t)layer].cannons.killOldest()) {
+        dropped++;
+        return true;
+    }
+    return false;
+}
+
+void BulletStore::clear() {
+    for (auto &layer : layers) {
+        layer.cannons.clear();
+        forEachBucket(layer, [](auto &bucket, Kind) { bucket.clear(); });
+    }
+}
+
+size_t BulletStore::size() const {
+    size_t count = 0ul;
+    for (const auto &layer : layers) {
+        count += layer.cannons.getLiveCount();
+        forEachBucket(layer, [&](const auto &bucket, Kind) {
+            count += bucket.size();
+        });
+    }
+    return count;
+}
+
+void BulletStore::update(float deltaTime, sf::Vector2f hitTarget) {
+    for (auto &layer : layers) {
+        layer.cannons.update(deltaTime);
+
+        forEachBucket(layer, [&](auto &bucket, Kind) {
+            for (size_t i = 0; i < bucket.size();) {
+                auto &bullet = *bucket[i]; // the final type, not Bullet
+                if (!bullet.isAvailable()) {
+                    bucket.eraseAt(i); // the last object moved into i
+                    continue;
+                }
+                bullet.storePreviousPosition();
+                bullet.update(deltaTime, hitTarget);
+                ++i;
+            }
+        });
+    }
+}
+
+void BulletStore::rebuildGrids() {
+    for (auto &layer : layers) {
+        SpatialGrid &grid = layer.grid;
+        grid.clear();
+        for (uint32_t i = 0; i < layer.cannons.getSlotCount(); i++)
+            if (layer.cannons.isAlive(i))
+                grid.insert(i, layer.cannons.getBounds(i));
+        forEachBucket(layer, [&](auto &bucket, Kind kind) {
+            for (uint32_t i = 0; i < bucket.size(); i++)
+                if (bucket[i]->isAvailable())
+                    grid.insert(i | (kind << KIND_SHIFT),
+                                bucket[i]->getBounds());
+        });
+        grid.build();
+    }
+}
+
+void BulletStore::render(sf::RenderWindow &window, SpriteBatch &batch,
+                         float alpha) {
+    for (auto &layer : layers) {
+        layer.cannons.render(batch, alpha);
+        forEachBucket(layer, [&](auto &bucket, Kind) {
+            for (const auto &bullet : bucket)
+                bullet->render(batch, alpha);
+        });
+    }
+    batch.flush(window);
+}
+
+boost::json::array BulletStore::serialize() const {
+    boost::json::array array;
+    for (const auto &layer : layers) {
+        for (uint32_t i = 0; i < layer.cannons.getSlotCount(); i++)
+            if (layer.cannons.isAlive(i))
+                array.push_back(layer.cannons.serialize(i));
+        forEachBucket(layer, [&](const auto &bucket, Kind) {
+            for (const auto &bullet : bucket)
+                array.push_back(bullet->serialize());
+        });
+    }
+    return array;
+}
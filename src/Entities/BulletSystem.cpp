@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Entities/BulletSystem.hpp"
+#include "Core/Constants.hpp"
+#include "Core/CpuDispatch.hpp"
+#include "Core/Math.hpp"
+#include "Core/ResourceManager.hpp"
+#include "Entities/Bullet.hpp"
+#include <algorithm>
+#include <cmath>
+
+BulletSystem::BulletSystem(bool from_player, size_t capacity)
+    : from_player(from_player), x(capacity, 0.0f), y(capacity, 0.0f),
+      prevX(capacity, 0.0f), prevY(capacity, 0.0f), vx(capacity, 0.0f),
+      vy(capacity, 0.0f), damage(capacity, 0.0f), id(capacity, 0),
+      alive(capacity, 0), generation(capacity, 0u),
+      spawnOrder(capacity * 2ul) {
+    for (size_t i = 0; i < TEXTURE_COUNT; i++) {
+        sf::Vector2u size =
+            ResourceManager::getTextureSize(Bullet::bullets_path[i]);
+        halfSizes[i] = sf::Vector2f(size.x / 2.0f, size.y / 2.0f);
+    }
+    freeSlots.reserve(capacity);
+    culled.reserve(capacity);
+}
+
+bool BulletSystem::spawn(sf::Vector2f position, sf::Vector2f direction,
+                         size_t id, float speed, float damage) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else if (slotCount < x.size()) {
+        slot = (uint32_t)slotCount++;
+    } else {
+        return false;
+    }
+
+    direction = Math::normalize(direction);
+    x[slot] = prevX[slot] = position.x;
+    y[slot] = prevY[slot] = position.y;
+    vx[slot] = direction.x * speed;
+    vy[slot] = direction.y * speed;
+    this->damage[slot] = damage;
+    this->id[slot] = (uint8_t)std::min(id, TEXTURE_COUNT - 1);
+    alive[slot] = 1;
+    liveCount++;
+
+    if (spawnOrderCount == spawnOrder.size()) {
+        // Squeeze out the entries of dead bullets; at most half are live
+        std::rotate(spawnOrder.begin(), spawnOrder.begin() + spawnOrderHead,
+                    spawnOrder.end());
+        size_t kept = 0ul;
+        for (size_t i = 0; i < spawnOrderCount; i++) {
+            uint64_t entry = spawnOrder[i];
+            uint32_t index = (uint32_t)entry;
+            if (alive[index] && generation[index] == (uint32_t)(entry >> 32))
+                spawnOrder[kept++] = entry;
+        }
+        spawnOrderHead = 0ul;
+        spawnOrderCount = kept;
+    }
+    spawnOrder[(spawnOrderHead + spawnOrderCount++) % spawnOrder.size()] =
+        (uint64_t)generation[slot] << 32 | slot;
+    return true;
+}
+
+bool BulletSystem::spawn(const boost::json::object &o) {
+    auto position = o.at("position").as_object();
+    auto direction = o.at("direction").as_object();
+    return spawn(sf::Vector2f((float)position.at("x").as_double(),
+                              (float)position.at("y").as_double()),
+                 sf::Vector2f((float)direction.at("x").as_double(),
+                              (float)direction.at("y").as_double()),
+                 (size_t)o.at("id").as_int64(),
+                 (float)o.at("speed").as_double(),
+                 (float)o.at("damage").as_double());
+}
+
+boost::json::object BulletSystem::serialize(uint32_t index) const {
+    const float speed = std::hypot(vx[index], vy[index]);
+    const sf::Vector2f direction =
+        speed > 0.0f ? sf::Vector2f(vx[index] / speed, vy[index] / speed)
+                     : sf::Vector2f(0.0f, 0.0f);
+    return {
+        {"type", "Cannon"},
+        {"avail", (bool)alive[index]},
+        {"position", {{"x", x[index]}, {"y", y[index]}}},
+        {"from_player", from_player},
+        {"damage", damage[index]},
+        {"damageRate", 0.0f},
+        {"time", 0.0f},
+        {"direction", {{"x", direction.x}, {"y", direction.y}}},
+        {"speed", speed},
+        {"id", id[index]},
+    };
+}
+
+void BulletSystem::update(float deltaTime) {
+    culled.clear();
+    CpuDispatch::integrate(x.data(), y.data(), prevX.data(), prevY.data(),
+                           vx.data(), vy.data(), culled, slotCount, deltaTime);
+    for (uint32_t slot : culled)
+        kill(slot);
+}
+
+void BulletSystem::render(SpriteBatch &batch, float alpha) {
+    if (!regions[0].texture)
+        for (size_t i = 0; i < TEXTURE_COUNT; i++)
+            regions[i] = ResourceManager::getRegion(Bullet::bullets_path[i]);
+
+    for (size_t i = 0; i < TEXTURE_COUNT; i++) {
+        drawX[i].clear();
+        drawY[i].clear();
+    }
+    for (size_t i = 0; i < slotCount; i++) {
+        if (!alive[i])
+            continue;
+        drawX[id[i]].push_back(prevX[i] + (x[i] - prevX[i]) * alpha);
+        drawY[id[i]].push_back(prevY[i] + (y[i] - prevY[i]) * alpha);
+    }
+    for (size_t i = 0; i < TEXTURE_COUNT; i++) {
+        batch.addQuads(regions[i].texture, regions[i].rect, halfSizes[i],
+                       drawX[i].data(), drawY[i].data(), drawX[i].size());
+    }
+}
+
+void BulletSystem::clear() {
+    for (size_t i = 0; i < slotCount; i++)
+        kill((uint32_t)i);
+    freeSlots.clear();
+    slotCount = 0ul;
+    spawnOrderHead = spawnOrderCount = 0ul;
+}
+
+bool BulletSystem::killOldest() {
+    while (spawnOrderCount > 0ul) {
+        uint64_t entry = spawnOrder[spawnOrderHead];
+        spawnOrderHead = (spawnOrderHead + 1) % spawnOrder.size();
+        spawnOrderCount--;
+        uint32_t index = (uint32_t)entry;
+        if (alive[index] && generation[index] == (uint32_t)(entry >> 32)) {
+            kill(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+void BulletSystem::kill(uint32_t index) {
+    if (!alive[index])
+        return;
+    alive[index] = 0;
+    generation[index]++;
+    liveCount--;
+    // Park the slot at rest inside the arena so the kernels leave it alone
+    x[index] = y[index] = prevX[index] = prevY[index] = 0.0f;
+    vx[index] = vy[index] = 0.0f;
+    freeSlots.push_back(index);
+}
+
+sf::FloatRect BulletSystem::getBounds(uint32_t index) const {
+    const sf::Vector2f half = halfSizes[id[index]];
+    return sf::FloatRect(x[index] - half.x, y[index] - half.y, half.x * 2.0f,
+                         half.y * 2.0f);
+}
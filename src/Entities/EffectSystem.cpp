@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Entities/EffectSystem.hpp"
+#include "Core/Constants.hpp"
+
+namespace {
+
+constexpr float FRAME_DURATION = 0.16f;
+// A blast flashes, then shows its image for as long again
+constexpr float BLAST_DURATION = 2.0f * ScreenEffects::FLASH_DURATION;
+
+const ParticleBurst MISSILE_SPARKS{
+    24, 120.0f, 360.0f, 0.25f, 0.6f, 3.0f, sf::Color(255, 240, 200)};
+const ParticleBurst ROCKET_SPARKS{
+    24, 120.0f, 360.0f, 0.25f, 0.6f, 3.0f, sf::Color(255, 140, 40)};
+const ParticleBurst DEATH_SPARKS{
+    16, 120.0f, 360.0f, 0.25f, 0.6f, 4.0f, sf::Color(255, 220, 120)};
+
+} // namespace
+
+EffectSystem::EffectSystem() : particles(Constants::PARTICLE_CAPACITY) {
+    blasts.reserve(Constants::EFFECT_CAPACITY);
+    animations.reserve(Constants::EFFECT_CAPACITY);
+}
+
+void EffectSystem::blast(BlastKind kind, sf::Vector2f position) {
+    if (ResourceManager::isHeadless())
+        return;
+    if (blasts.size() < Constants::EFFECT_CAPACITY)
+        blasts.push_back({kind, 0.0f});
+    else
+        dropped++;
+    particles.emit(kind == BlastKind::Missile ? MISSILE_SPARKS : ROCKET_SPARKS,
+                   position);
+}
+
+void EffectSystem::playFrames(const ResourceManager::TextureRegion *frames,
+                              size_t count, sf::Vector2f position,
+                              sf::Vector2f velocity, bool flipped,
+                              sf::Color color) {
+    if (ResourceManager::isHeadless() || count == 0ul)
+        return;
+    if (animations.size() < Constants::EFFECT_CAPACITY)
+        animations.push_back(
+            {frames, count, position, velocity, flipped, color, 0.0f});
+    else
+        dropped++;
+    // From the middle of the first frame
+    const sf::Vector2f half(frames[0].rect.width / 2.0f,
+                            frames[0].rect.height / 2.0f);
+    particles.emit(DEATH_SPARKS, flipped ? position - half : position + half,
+                   velocity);
+}
+
+void EffectSystem::update(float deltaTime) {
+    for (size_t i = 0; i < blasts.size();) {
+        blasts[i].age += deltaTime;
+        if (blasts[i].age >= BLAST_DURATION) {
+            blasts[i] = blasts.back();
+            blasts.pop_back();
+            continue;
+        }
+        ++i;
+    }
+    for (size_t i = 0; i < animations.size();) {
+        Animation &animation = animations[i];
+        animation.age += deltaTime;
+        if (animation.age >= animation.count * FRAME_DURATION) {
+            animation = animations.back();
+            animations.pop_back();
+            continue;
+        }
+        animation.position += animation.velocity * deltaTime;
+        ++i;
+    }
+    particles.update(deltaTime);
+}
+
+void EffectSystem::render(sf::RenderWindow &window, SpriteBatch &batch,
+                          ScreenEffects &screen) {
+    for (const Blast &blast : blasts) {
+        const bool missile = blast.kind == BlastKind::Missile;
+        if (blast.age < ScreenEffects::FLASH_DURATION)
+            screen.flash(missile ? sf::Color(255, 255, 255, 220)
+                                 : sf::Color(255, 69, 1, 128),
+                         blast.age);
+        screen.overlay(ResourceManager::getRegion(
+            missile ? "assets/explode.png" : "assets/explode2.png"));
+    }
+    screen.draw(window);
+
+    for (const Animation &animation : animations) {
+        const ResourceManager::TextureRegion &frame =
+            animation.frames[(size_t)(animation.age / FRAME_DURATION)];
+        sf::Transform transform;
+        transform.translate(animation.position);
+        if (animation.flipped)
+            transform.rotate(180.0f);
+        batch.add(frame.texture, frame.rect, transform, animation.color);
+    }
+    particles.render(batch);
+    batch.flush(window);
+}
+
+void EffectSystem::clear() {
+    blasts.clear();
+    animations.clear();
+    particles.clear();
+}
+
+size_t EffectSystem::size() const {
+    return blasts.size() + animations.size() + particles.size();
+}
+
+uint64_t EffectSystem::getDroppedCount() const {
+    return dropped + particles.getDroppedCount();
+}
@@ -0,0 +1,582 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Entities/EnemySystem.hpp"
+#include "Core/Math.hpp"
+#include "Core/RandomUtils.hpp"
+#include "Core/ResourceManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+std::string texturePath(int level, const std::string &suffix) {
+    return std::string("assets/enemy") + std::to_string(level) + suffix;
+}
+
+float drawStat(RandomStream &random, StatRange range) {
+    return range.isFixed()
+               ? range.min
+               : RandomUtils::generateInRange(random, range.min, range.max);
+}
+
+// Charmed enemies turn 180 degrees around their top-left corner
+template <typename Kind> bool isFlipped(const Status &status) {
+    return Kind::CHARMABLE && status.charmed;
+}
+
+sf::FloatRect boundsOf(const Motion &motion, bool flipped) {
+    const sf::Vector2f corner =
+        flipped ? motion.position - motion.size : motion.position;
+    return {corner, motion.size};
+}
+
+bool isOnScreen(sf::Vector2f position) {
+    return position.x >= 0 && position.x < Constants::SCREEN_WIDTH &&
+           position.y >= 0 && position.y <= Constants::SCREEN_HEIGHT;
+}
+
+template <typename Kind> using KindOf = std::decay_t<Kind>;
+
+// Every kind sits at index LEVEL - 1 of EnemySystem::Kinds
+template <typename Tuple, size_t... I>
+constexpr bool isLevelOrdered(std::index_sequence<I...>) {
+    return ((std::tuple_element_t<I, Tuple>::LEVEL == (int)I + 1) && ...);
+}
+
+} // namespace
+
+template <typename Kind>
+void DiveMovement::move(Kind &enemies, size_t begin, size_t end,
+                        float deltaTime) {
+    constexpr float hoverLine =
+        Constants::SCREEN_HEIGHT * ENEMY_STATS[Kind::LEVEL].hoverLine;
+    auto &motion = enemies.template column<Motion>();
+    auto &status = enemies.template column<Status>();
+    for (size_t i = begin; i < end; i++) {
+        Motion &m = motion[i];
+        Status &s = status[i];
+        if (!s.avail)
+            continue;
+        if (s.charmed && m.position.y >= hoverLine)
+            m.speed = 0.0f;
+        m.position.y += m.speed * deltaTime * (s.charmed ? -1 : 1);
+        if constexpr (Kind::template has<Weave>()) {
+            Weave &w = enemies.template column<Weave>()[i];
+            w.time += deltaTime;
+            m.position.x =
+                w.center + std::sin(w.time * w.frequency) * w.amplitude;
+            s.avail =
+                m.position.y >= 0 && m.position.y <= Constants::SCREEN_HEIGHT;
+        } else {
+            s.avail = isOnScreen(m.position);
+        }
+    }
+}
+
+template <typename Kind>
+void BossMovement::move(Kind &enemies, size_t begin, size_t end,
+                        float deltaTime) {
+    auto &motion = enemies.template column<Motion>();
+    auto &weave = enemies.template column<Weave>();
+    auto &status = enemies.template column<Status>();
+    for (size_t i = begin; i < end; i++) {
+        Motion &m = motion[i];
+        Weave &w = weave[i];
+        Status &s = status[i];
+        if (!s.avail)
+            continue;
+        w.time += deltaTime;
+        if (m.position.y > (float)Constants::SCREEN_HEIGHT / 4)
+            m.position.y += m.speed * deltaTime;
+        m.position.x = w.center + std::sin(w.time * w.frequency) * w.amplitude;
+        s.avail = isOnScreen(m.position);
+    }
+}
+
+void SingleShotGun::fire(BulletStore &bullets, const sf::FloatRect &bounds,
+                         const Vitals &vitals, Weapon &weapon,
+                         const Status &status) {
+    const float centerX = bounds.left + bounds.width / 2.0f;
+    if (status.charmed)
+        bullets.fire(Volleys::CHARMED_ENEMY_SHOT,
+                     {{centerX, bounds.top}, weapon.bulletSpeed, weapon.damage,
+                      true},
+                     weapon.random);
+    else
+        bullets.fire(Volleys::ENEMY_SHOT,
+                     {{centerX, bounds.top + bounds.height}, weapon.bulletSpeed,
+                      weapon.damage, false},
+                     weapon.random);
+}
+
+void VolleyGun::fire(BulletStore &bullets, const sf::FloatRect &bounds,
+                     const Vitals &vitals, Weapon &weapon,
+                     const Status &status) {
+    static size_t shootCounter = 0;
+
+    const Shooter boss{{bounds.left + bounds.width / 2.0f,
+                        bounds.top + bounds.height},
+                       weapon.bulletSpeed,
+                       weapon.damage,
+                       false};
+    bullets.fire(Volleys::BOSS_SPREAD, boss, weapon.random);
+
+    shootCounter = (shootCounter + 1) % 16;
+    if (shootCounter == 0 || (vitals.health < 12480.0f)) {
+        const int ranks = vitals.health < vitals.maxHealth * 0.4f ? 4 : 2;
+        bullets.fire(Volleys::BOSS_MISSILES_LEFT.withCount(ranks), boss,
+                     weapon.random);
+        bullets.fire(Volleys::BOSS_MISSILES_RIGHT.withCount(ranks), boss,
+                     weapon.random);
+        ResourceManager::playSound("assets/missile.wav");
+    } else if (shootCounter == 4 || shootCounter == 6 ||
+               (vitals.health < vitals.maxHealth * 0.32f &&
+                shootCounter == 9)) {
+        bullets.fire(Volleys::BOSS_ROCKET_LEFT, boss, weapon.random);
+        bullets.fire(Volleys::BOSS_ROCKET_RIGHT, boss, weapon.random);
+        ResourceManager::playSound("assets/rocket.wav");
+    } else {
+        ResourceManager::playSound("assets/bullet.wav");
+    }
+}
+
+EnemySystem::EnemySystem(Scheduler &scheduler, BulletStore &bullets,
+                         EffectSystem &effects, JobSystem &jobs)
+    : scheduler(scheduler), bullets(bullets), effects(effects), jobs(jobs) {
+    static_assert(std::tuple_size_v<Kinds> == Constants::ENEMY_LEVEL_COUNT);
+    static_assert(isLevelOrdered<Kinds>(
+        std::make_index_sequence<std::tuple_size_v<Kinds>>()));
+}
+
+const EnemyPrefab &EnemySystem::prefab(int level) {
+    std::optional<EnemyPrefab> &prefab = prefabs[level];
+    if (prefab)
+        return *prefab;
+
+    prefab.emplace();
+    prefab->frames.push_back(
+        ResourceManager::getRegion(texturePath(level, ".png")));
+    prefab->frames.push_back(
+        ResourceManager::getRegion(texturePath(level, "_hit.png")));
+    for (int frame = 1;; frame++) {
+        std::string path =
+            texturePath(level, "_down" + std::to_string(frame) + ".png");
+        if (!ResourceManager::getTextureifExists(path))
+            break;
+        prefab->frames.push_back(ResourceManager::getRegion(path));
+    }
+    const sf::IntRect &base = prefab->frames[EnemyPrefab::BASE_FRAME].rect;
+    prefab->size = {(float)base.width, (float)base.height};
+    prefab->downSound = texturePath(level, "_down.wav");
+    return *prefab;
+}
+
+EnemyHandle EnemySystem::spawn(int level, sf::Vector2f position) {
+    EnemyHandle handle;
+    forEachKind([&](auto &enemies) {
+        if (KindOf<decltype(enemies)>::LEVEL == level)
+            handle = spawn(enemies, position);
+    });
+    return handle;
+}
+
+template <typename Kind>
+EnemyHandle EnemySystem::spawn(Kind &enemies, sf::Vector2f position) {
+    constexpr const EnemyStats &stats = ENEMY_STATS[Kind::LEVEL];
+
+    // Drawn in this order so that a given seed spawns the same enemy
+    RandomStream random(RandomStreamId::Enemies, spawnCount++);
+    Vitals vitals;
+    vitals.maxHealth = vitals.health = drawStat(random, stats.health);
+    Motion motion{position, position, {}, drawStat(random, stats.speed)};
+    Weapon weapon;
+    weapon.bulletSpeed = stats.bulletSpeedScale > 0.0f
+                             ? motion.speed * stats.bulletSpeedScale
+                             : drawStat(random, stats.bulletSpeed);
+    weapon.shotGap = drawStat(random, stats.shotGap);
+    weapon.damage = stats.damage;
+    vitals.killBonus =
+        stats.killBonus + stats.killBonusHealthShare * vitals.maxHealth;
+
+    Weave weave{};
+    if constexpr (Kind::template has<Weave>()) {
+        weave.amplitude = drawStat(random, stats.weaveAmplitude);
+        weave.frequency = drawStat(random, stats.weaveFrequency);
+        weave.center = position.x;
+    }
+    weapon.random = random;
+    Regen regen{stats.regenRate};
+    Status status{true, false, false};
+    return insert(enemies, motion, weave, vitals, regen, weapon, status);
+}
+
+EnemyHandle EnemySystem::spawn(const boost::json::object &o) {
+    auto position_obj = o.at("position").as_object();
+    sf::Vector2f position((float)position_obj.at("x").as_double(),
+                          (float)position_obj.at("y").as_double());
+
+    Motion motion{position, position, {}, (float)o.at("speed").as_double()};
+    Vitals vitals{(float)o.at("health").as_double(),
+                  (float)o.at("maxHealth").as_double(),
+                  (float)o.at("killBonus").as_double()};
+    Weapon weapon{(float)o.at("bulletspeed").as_double(),
+                  (float)o.at("current_shot_gap").as_double(),
+                  (float)o.at("damage").as_double(),
+                  {RandomStreamId::Enemies, spawnCount++}};
+    Status status{o.at("avail").as_bool(), o.at("charmed").as_bool(),
+                  o.at("bonusTaken").as_bool()};
+
+    const int level = (int)o.at("level").as_int64();
+    EnemyHandle handle;
+    forEachKind([&](auto &enemies) {
+        using Kind = KindOf<decltype(enemies)>;
+        if (Kind::LEVEL != level)
+            return;
+        Weave weave{};
+        if constexpr (Kind::template has<Weave>()) {
+            weave.amplitude = (float)o.at("verticalAmplitude").as_double();
+            weave.frequency = (float)o.at("verticalFrequency").as_double();
+            weave.center = (float)o.at("verticalCenter").as_double();
+            weave.time = (float)o.at("time").as_double();
+        }
+        Regen regen{};
+        if constexpr (Kind::template has<Regen>())
+            regen.rate = (float)o.at("recoverRate").as_double();
+        handle = insert(enemies, motion, weave, vitals, regen, weapon, status);
+    });
+    return handle;
+}
+
+template <typename Kind>
+EnemyHandle EnemySystem::insert(Kind &enemies, Motion &motion, Weave &weave,
+                                Vitals &vitals, Regen &regen, Weapon &weapon,
+                                Status &status) {
+    const EnemyPrefab &base = prefab(Kind::LEVEL);
+    Visual visual;
+    visual.frame = EnemyPrefab::BASE_FRAME;
+    motion.size = base.size;
+    const SlotIndex::Handle handle = enemies.createFrom(
+        motion, weave, vitals, regen, weapon, status, visual);
+    enemies.template column<Visual>().back().shotTask = scheduler.schedule(
+        enemies.template column<Weapon>().back().shotGap,
+        [this, &enemies, handle] { return shoot(enemies, handle); });
+    return {Kind::LEVEL, handle};
+}
+
+template <typename Kind>
+float EnemySystem::shoot(Kind &enemies, SlotIndex::Handle handle) {
+    if (!enemies.contains(handle))
+        return 0.0f;
+    const size_t i = enemies.indexOf(handle);
+    const Status &status = enemies.template column<Status>()[i];
+    const Vitals &vitals = enemies.template column<Vitals>()[i];
+    Weapon &weapon = enemies.template column<Weapon>()[i];
+    if (!status.avail || vitals.health <= 0.0f)
+        return 0.0f;
+
+    const Motion &motion = enemies.template column<Motion>()[i];
+    Kind::Gun::fire(bullets, boundsOf(motion, isFlipped<Kind>(status)),
+                    vitals, weapon, status);
+    return weapon.shotGap;
+}
+
+void EnemySystem::removeDeparted(EnemyReport &report) {
+    forEachKind([&](auto &enemies) { sweep(enemies, report); });
+}
+
+void EnemySystem::move(float deltaTime) {
+    forEachKind([&](auto &enemies) {
+        using Kind = KindOf<decltype(enemies)>;
+        for (Motion &motion : enemies.template column<Motion>())
+            motion.previous = motion.position;
+        jobs.parallelFor(enemies.size(), Constants::ENEMY_CHUNK_SIZE,
+                         [&](size_t, size_t begin, size_t end) {
+                             Kind::Movement::move(enemies, begin, end,
+                                                  deltaTime);
+                         });
+    });
+}
+
+void EnemySystem::collide(float deltaTime, EnemyReport &report) {
+    forEachKind([&](auto &enemies) {
+        animate(enemies, deltaTime);
+        collideKind(enemies, report);
+    });
+}
+
+template <typename Kind>
+void EnemySystem::sweep(Kind &enemies, EnemyReport &report) {
+    auto &status = enemies.template column<Status>();
+    auto &vitals = enemies.template column<Vitals>();
+    for (size_t i = 0; i < enemies.size();) {
+        Status &s = status[i];
+        if (s.avail) {
+            ++i;
+            continue;
+        }
+        if (!s.bonusTaken && vitals[i].health <= 0.0f) {
+            report.bonus += vitals[i].killBonus;
+            report.killed++;
+            s.bonusTaken = true;
+        }
+        report.departed[Kind::LEVEL]++;
+        enemies.eraseAt(i); // the last enemy moved into i
+    }
+}
+
+// Hands the death animation of enemies out of health to the EffectSystem
+// and marks them for removal, and regenerates the others
+template <typename Kind>
+void EnemySystem::animate(Kind &enemies, float deltaTime) {
+    auto &status = enemies.template column<Status>();
+    auto &vitals = enemies.template column<Vitals>();
+    for (size_t i = 0; i < enemies.size(); i++) {
+        Status &s = status[i];
+        Vitals &v = vitals[i];
+        if (!s.avail)
+            continue;
+
+        if (v.health > 0.0f) {
+            if constexpr (Kind::template has<Regen>()) {
+                const Regen &regen = enemies.template column<Regen>()[i];
+                v.health = std::min(v.health + deltaTime * regen.rate,
+                                    v.maxHealth * 2.0f);
+            } else if (Kind::CHARMABLE && s.charmed) {
+                v.health = std::min(v.maxHealth * 15.0f,
+                                    deltaTime * 240.0f + v.health);
+            }
+            continue;
+        }
+
+        const EnemyPrefab &base = *prefabs[Kind::LEVEL];
+        const Motion &m = enemies.template column<Motion>()[i];
+        ResourceManager::playSound(base.downSound);
+        effects.playFrames(
+            base.frames.data() + EnemyPrefab::FIRST_DOWN_FRAME,
+            base.frames.size() - EnemyPrefab::FIRST_DOWN_FRAME, m.position,
+            (m.position - m.previous) / deltaTime, isFlipped<Kind>(s),
+            s.charmed ? sf::Color::Cyan : sf::Color::Yellow);
+        s.avail = false;
+    }
+}
+
+template <typename Kind>
+void EnemySystem::collideKind(Kind &enemies, EnemyReport &report) {
+    const size_t chunks =
+        JobSystem::chunkCount(enemies.size(), Constants::ENEMY_CHUNK_SIZE);
+    if (hitBuffers.size() < chunks)
+        hitBuffers.resize(chunks);
+    jobs.parallelFor(enemies.size(), Constants::ENEMY_CHUNK_SIZE,
+                     [&](size_t chunk, size_t begin, size_t end) {
+                         findHits(enemies, begin, end, hitBuffers[chunk]);
+                     });
+
+    // Chunks hold consecutive rows, so this is the serial order
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        HitBuffer &buffer = hitBuffers[chunk];
+        for (const Hit &hit : buffer.hits)
+            applyHit(enemies, hit);
+        bullets.addQueryStats(buffer.stats);
+        buffer.hits.clear();
+        buffer.stats = {};
+    }
+
+    auto &vitals = enemies.template column<Vitals>();
+    auto &status = enemies.template column<Status>();
+    for (size_t i = 0; i < enemies.size(); i++) {
+        Status &s = status[i];
+        if (s.avail && !s.bonusTaken && s.charmed) {
+            report.bonus += vitals[i].killBonus;
+            report.killed++;
+            report.departed[Kind::LEVEL]++;
+            s.bonusTaken = true;
+        }
+    }
+}
+
+// Only reads the enemies and the bullets, so chunks may run in parallel
+template <typename Kind>
+void EnemySystem::findHits(Kind &enemies, size_t begin, size_t end,
+                           HitBuffer &buffer) {
+    const auto &motion = enemies.template column<Motion>();
+    const auto &vitals = enemies.template column<Vitals>();
+    const auto &status = enemies.template column<Status>();
+    for (size_t i = begin; i < end; i++) {
+        const Status &s = status[i];
+        if (!s.avail || vitals[i].health <= 0.0f)
+            continue;
+        const ColliderLayer layer =
+            s.charmed ? ColliderLayer::CharmedEnemy : ColliderLayer::Enemy;
+        const sf::FloatRect bounds = boundsOf(motion[i], isFlipped<Kind>(s));
+        bullets.query(
+            layer, bounds,
+            [&](BulletRef bullet) {
+                buffer.hits.push_back({(uint32_t)i, s.charmed, bullet});
+            },
+            buffer.stats);
+    }
+}
+
+template <typename Kind>
+void EnemySystem::applyHit(Kind &enemies, const Hit &hit) {
+    Motion &m = enemies.template column<Motion>()[hit.row];
+    Vitals &v = enemies.template column<Vitals>()[hit.row];
+    Status &s = enemies.template column<Status>()[hit.row];
+    BulletRef bullet = hit.bullet;
+    // Charmed by an earlier bullet, the rest are no longer hostile. The
+    // bullet may also have been spent on an earlier enemy.
+    if (s.charmed != hit.wasCharmed || !bullet.isAlive())
+        return;
+
+    if (Kind::CHARMABLE && bullet.isCharming()) {
+        s.charmed = true;
+        m.speed /= -2.0f;
+        v.health *= 10.0f;
+        enemies.template column<Weapon>()[hit.row].damage *= 1.6f;
+        bullet.destroy();
+        ResourceManager::playSound("assets/AllMyPeople.wav");
+    } else {
+        v.health -=
+            std::max(bullet.getDamage(), bullet.getDamageRate() * v.health);
+        enemies.template column<Visual>()[hit.row].frame =
+            EnemyPrefab::HIT_FRAME;
+        bullet.explodeSoundOnly();
+        bullet.destroy();
+    }
+}
+
+void EnemySystem::render(sf::RenderWindow &window, SpriteBatch &batch,
+                         float alpha) {
+    forEachKind([&](auto &enemies) { draw(enemies, batch, alpha); });
+    batch.flush(window);
+}
+
+template <typename Kind>
+void EnemySystem::draw(Kind &enemies, SpriteBatch &batch, float alpha) {
+    if (enemies.size() == 0ul)
+        return;
+    const EnemyPrefab &base = *prefabs[Kind::LEVEL]; // resolved by a spawn
+    const auto &motion = enemies.template column<Motion>();
+    const auto &status = enemies.template column<Status>();
+    const auto &visual = enemies.template column<Visual>();
+    for (size_t i = 0; i < enemies.size(); i++) {
+        const Status &s = status[i];
+        if (!s.avail)
+            continue;
+        sf::Transform transform;
+        transform.translate(
+            Math::lerp(motion[i].previous, motion[i].position, alpha));
+        if (isFlipped<Kind>(s))
+            transform.rotate(180.0f);
+        const ResourceManager::TextureRegion &frame =
+            base.frames[visual[i].frame];
+        batch.add(frame.texture, frame.rect, transform,
+                  s.charmed ? sf::Color::Cyan : sf::Color::Yellow);
+    }
+}
+
+void EnemySystem::clear() {
+    forEachKind([](auto &enemies) { enemies.clear(); });
+}
+
+const Vitals *EnemySystem::getVitals(EnemyHandle enemy) const {
+    const Vitals *vitals = nullptr;
+    forEachKind([&](const auto &enemies) {
+        if (KindOf<decltype(enemies)>::LEVEL == enemy.level &&
+            enemies.contains(enemy.handle))
+            vitals = &enemies.template column<Vitals>()[enemies.indexOf(
+                enemy.handle)];
+    });
+    return vitals;
+}
+
+bool EnemySystem::findStrongestCharmed(sf::Vector2f &position) const {
+    float maxCharmedHealth = 0.0f;
+    forEachKind([&](const auto &enemies) {
+        if constexpr (!KindOf<decltype(enemies)>::CHARMABLE)
+            return;
+        const auto &motion = enemies.template column<Motion>();
+        const auto &vitals = enemies.template column<Vitals>();
+        const auto &status = enemies.template column<Status>();
+        for (size_t i = 0; i < enemies.size(); i++) {
+            if (status[i].avail && status[i].charmed &&
+                vitals[i].health > maxCharmedHealth) {
+                position = motion[i].position;
+                maxCharmedHealth = vitals[i].health;
+            }
+        }
+    });
+    return maxCharmedHealth > 0.0f;
+}
+
+int EnemySystem::countHostile(int level) const {
+    int count = 0;
+    forEachKind([&](const auto &enemies) {
+        if (KindOf<decltype(enemies)>::LEVEL != level)
+            return;
+        for (const Status &status : enemies.template column<Status>())
+            if (status.avail && !status.charmed)
+                count++;
+    });
+    return count;
+}
+
+size_t EnemySystem::size() const {
+    size_t count = 0ul;
+    forEachKind([&](const auto &enemies) { count += enemies.size(); });
+    return count;
+}
+
+boost::json::array EnemySystem::serialize() const {
+    boost::json::array array;
+    forEachKind([&](const auto &enemies) {
+        using Kind = KindOf<decltype(enemies)>;
+        for (size_t i = 0; i < enemies.size(); i++) {
+            const Motion &m = enemies.template column<Motion>()[i];
+            const Vitals &v = enemies.template column<Vitals>()[i];
+            const Weapon &w = enemies.template column<Weapon>()[i];
+            const Status &s = enemies.template column<Status>()[i];
+            boost::json::object o = {
+                {"avail", s.avail},
+                {"position", {{"x", m.position.x}, {"y", m.position.y}}},
+                {"level", Kind::LEVEL},
+                {"health", v.health},
+                {"maxHealth", v.maxHealth},
+                {"killBonus", v.killBonus},
+                {"speed", m.speed},
+                {"bulletspeed", w.bulletSpeed},
+                {"current_shot_gap", w.shotGap},
+                {"damage", w.damage},
+                {"charmed", s.charmed},
+                {"bonusTaken", s.bonusTaken},
+            };
+            if constexpr (Kind::template has<Weave>()) {
+                const Weave &weave = enemies.template column<Weave>()[i];
+                o["verticalAmplitude"] = weave.amplitude;
+                o["verticalFrequency"] = weave.frequency;
+                o["verticalCenter"] = weave.center;
+                o["time"] = weave.time;
+            }
+            if constexpr (Kind::template has<Regen>())
+                o["recoverRate"] = enemies.template column<Regen>()[i].rate;
+            array.push_back(std::move(o));
+        }
+    });
+    return array;
+}
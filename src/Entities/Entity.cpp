@@ -15,21 +15,24 @@
  */
 
 #include "Entities/Entity.hpp"
+#include "Core/Math.hpp"
 
-void Entity::render(sf::RenderWindow &window) {
-    if (avail)
-        window.draw(sprite);
+void Entity::storePreviousPosition() {
+    previousPosition = getPosition();
+    hasPreviousPosition = true;
 }
 
-sf::Vector2f Entity::getPosition() { return sprite.getPosition(); }
-
-sf::FloatRect Entity::getBounds() const { return sprite.getGlobalBounds(); }
+sf::Vector2f Entity::getRenderPosition(float alpha) const {
+    if (!hasPreviousPosition)
+        return getPosition();
+    return Math::lerp(previousPosition, getPosition(), alpha);
+}
 
 boost::json::object Entity::serialize() const {
+    const sf::Vector2f position = getPosition();
     return {
         {"avail", true},
-        {"position",
-         {{"x", sprite.getPosition().x}, {"y", sprite.getPosition().y}}},
+        {"position", {{"x", position.x}, {"y", position.y}}},
     };
 }
 
@@ -38,5 +41,28 @@ void Entity::deserialize(const boost::json::object &o) {
     auto dir_obj = o.at("position").as_object();
     float x = (float)dir_obj.at("x").as_double();
     float y = (float)dir_obj.at("y").as_double();
-    sprite.setPosition(x, y);
+    setPosition(sf::Vector2f(x, y));
+}
+
+void SpriteEntity::render(sf::RenderWindow &window, float alpha) {
+    if (avail)
+        drawInterpolated(window, sprite, alpha);
+}
+
+sf::FloatRect SpriteEntity::getBounds() const {
+    return sprite.getGlobalBounds();
+}
+
+sf::Vector2f SpriteEntity::getPosition() const { return sprite.getPosition(); }
+
+void SpriteEntity::setPosition(sf::Vector2f position) {
+    sprite.setPosition(position);
+}
+
+void SpriteEntity::drawInterpolated(sf::RenderWindow &window,
+                                    sf::Sprite &target, float alpha) const {
+    const sf::Vector2f current = target.getPosition();
+    target.setPosition(getRenderPosition(alpha));
+    window.draw(target);
+    target.setPosition(current);
 }
@@ -17,23 +17,24 @@
 #include "Entities/Gift.hpp"
 #include "Core/RandomUtils.hpp"
 #include "Core/ResourceManager.hpp"
+#include <algorithm>
 
 Gift::Gift(const boost::json::object &o) {
     deserialize(o);
-    sprite.setTexture(ResourceManager::getTexture("assets/" + name + ".png"));
+    ResourceManager::setSpriteTexture(sprite, "assets/" + name + ".png");
     constexpr float iconSize = 80.0f;
     auto bounds = sprite.getLocalBounds();
     float scale = iconSize / bounds.height;
     sprite.setScale(scale, scale);
 }
 
-Gift::Gift(const std::string &name) : name(name) {
+Gift::Gift(const std::string &name, RandomStream &random) : name(name) {
     avail = true;
-    remainingTime = (float)RandomUtils::generateInRange(7, 10);
+    lifetime = (float)RandomUtils::generateInRange(random, 7, 10);
     if (name == "AllMyPeople")
-        remainingTime += 4.0f; // Extra time for AllMyPeople
-    maxTime = remainingTime;
-    sprite.setTexture(ResourceManager::getTexture("assets/" + name + ".png"));
+        lifetime += 4.0f; // Extra time for AllMyPeople
+    maxTime = lifetime;
+    ResourceManager::setSpriteTexture(sprite, "assets/" + name + ".png");
     ResourceManager::playSound("assets/" + name + ".wav");
     constexpr float iconSize = 80.0f;
     auto bounds = sprite.getLocalBounds();
@@ -41,31 +42,43 @@ Gift::Gift(const std::string &name) : name(name) {
     sprite.setScale(scale, scale);
 }
 
-void Gift::update(float deltaTime) {
-    if (!avail)
-        return;
-    remainingTime -= deltaTime;
-    if (!disappearing && remainingTime <= 3.5f) {
+void Gift::startCountdown(Scheduler &scheduler) {
+    const float remaining = getRemainingTime();
+    expireTask = scheduler.schedule(remaining, [this] {
+        avail = false;
+        ResourceManager::playSound("assets/gift_disappear2.wav");
+        return 0.0f;
+    });
+    disappearTask =
+        scheduler.schedule(disappearing ? 0.0f : remaining - 3.5f,
+                           [this] { return updateDisappearing(); });
+}
+
+// Returns the delay until the next disappearing sound, 0 when all played
+float Gift::updateDisappearing() {
+    if (!disappearing) {
         disappearingTimer.restart();
         disappearing = true;
     }
-    if (disappearing) {
-        if (!disappearingSound1Played && disappearingTimer.hasElapsed(0.72f)) {
-            ResourceManager::playSound("assets/gift_disappear1.wav");
-            disappearingSound1Played = true;
-        } else if (!disappearingSound2Played &&
-                   disappearingTimer.hasElapsed(1.72f)) {
-            ResourceManager::playSound("assets/gift_disappear1.wav");
-            disappearingSound2Played = true;
-        }
+    const float elapsed = disappearingTimer.getElapsedTime();
+    if (!disappearingSound1Played) {
+        if (elapsed < 0.72f)
+            return 0.72f - elapsed;
+        ResourceManager::playSound("assets/gift_disappear1.wav");
+        disappearingSound1Played = true;
     }
-    if (remainingTime <= 0.0f) {
-        avail = false;
-        ResourceManager::playSound("assets/gift_disappear2.wav");
+    if (!disappearingSound2Played) {
+        if (elapsed < 1.72f)
+            return 1.72f - elapsed;
+        ResourceManager::playSound("assets/gift_disappear1.wav");
+        disappearingSound2Played = true;
     }
+    return 0.0f;
 }
 
-float Gift::getRemainingTime() const { return remainingTime; }
+float Gift::getRemainingTime() const {
+    return std::max(0.0f, lifetime - lifeTimer.getElapsedTime());
+}
 
 sf::Sprite &Gift::getSprite() { return sprite; }
 
@@ -76,7 +89,7 @@ boost::json::object Gift::serialize() const {
     o["speedIncrease"] = speedIncrease;
     o["charming"] = charming;
     o["name"] = name;
-    o["remainingTime"] = remainingTime;
+    o["remainingTime"] = getRemainingTime();
     o["maxTime"] = maxTime;
     o["disappearingTime"] = disappearingTimer.getElapsedTime();
     o["disappearing"] = disappearing;
@@ -92,7 +105,8 @@ void Gift::deserialize(const boost::json::object &o) {
     speedIncrease = (float)o.at("speedIncrease").as_double();
     charming = o.at("charming").as_bool();
     name = o.at("name").as_string();
-    remainingTime = (float)o.at("remainingTime").as_double();
+    lifetime = (float)o.at("remainingTime").as_double();
+    lifeTimer.restart();
     maxTime = (float)o.at("maxTime").as_double();
     disappearingTimer.setElapsedTime(
         (float)o.at("disappearingTime").as_double());
@@ -101,28 +115,30 @@ void Gift::deserialize(const boost::json::object &o) {
     disappearingSound2Played = o.at("disappearingSound2Played").as_bool();
 }
 
-FullFirePower::FullFirePower() : Gift("FullFirePower") {
+FullFirePower::FullFirePower(RandomStream &random)
+    : Gift("FullFirePower", random) {
     attackSpeedIncrease = 4.0f; // +400%
     speedIncrease = 0.0f;
     damageReduction = 0.0f;
     charming = false;
 }
 
-CenturyShield::CenturyShield() : Gift("CenturyShield") {
+CenturyShield::CenturyShield(RandomStream &random)
+    : Gift("CenturyShield", random) {
     attackSpeedIncrease = 0.0f;
     speedIncrease = 0.0f;
     damageReduction = 0.9f; // -90%
     charming = false;
 }
 
-AllMyPeople::AllMyPeople() : Gift("AllMyPeople") {
+AllMyPeople::AllMyPeople(RandomStream &random) : Gift("AllMyPeople", random) {
     attackSpeedIncrease = 0.0f;
     speedIncrease = 0.0f;
     damageReduction = 0.0f;
     charming = true;
 }
 
-SpeedStorm::SpeedStorm() : Gift("SpeedStorm") {
+SpeedStorm::SpeedStorm(RandomStream &random) : Gift("SpeedStorm", random) {
     attackSpeedIncrease = 0.0f;
     speedIncrease = 0.3f; // +30%
     damageReduction = 0.0f;
@@ -16,8 +16,6 @@
 
 #include "Entities/Player.hpp"
 #include "Core/Constants.hpp"
-#include "Core/Math.hpp"
-#include "Core/RandomUtils.hpp"
 #include "Core/ResourceManager.hpp"
 #include <algorithm>
 
@@ -29,21 +27,17 @@ Player::Player()
       speed(Constants::PLAYER_SPEED), current_texture(0) {
     avail = true;
 
-    for (const auto &image : images)
-        ResourceManager::getTexture(image).setSmooth(true);
-
-    sprite.setTexture(ResourceManager::getTexture(images[0]));
-    sf::Vector2u playerSize = sprite.getTexture()->getSize();
-    sprite.setOrigin(playerSize.x / 2.0f, playerSize.y / 2.0f);
+    ResourceManager::setSpriteTexture(sprite, images[0]);
+    sf::FloatRect playerSize = sprite.getLocalBounds();
+    sprite.setOrigin(playerSize.width / 2.0f, playerSize.height / 2.0f);
     sprite.setPosition(400.0f, 500.0f);
     sprite.setScale(0.64f, 0.64f);
     sprite.setColor(sf::Color::Cyan);
 
     // Configure the shield sprite
-    shieldSprite.setTexture(
-        ResourceManager::getTexture("assets/PlayerShield.png"));
-    sf::Vector2u shieldSize = shieldSprite.getTexture()->getSize();
-    shieldSprite.setOrigin(shieldSize.x / 2.0f, shieldSize.y / 2.0f);
+    ResourceManager::setSpriteTexture(shieldSprite, "assets/PlayerShield.png");
+    sf::FloatRect shieldSize = shieldSprite.getLocalBounds();
+    shieldSprite.setOrigin(shieldSize.width / 2.0f, shieldSize.height / 2.0f);
     shieldSprite.setScale(0.64f, 0.64f);
     shieldSprite.setPosition(sprite.getPosition());
 }
@@ -53,8 +47,8 @@ void Player::update(float deltaTime) {
         health = 0.0f;
         if (deathTimer.hasElapsed(0.4f)) {
             if (destroyFrameIdx < deathImages.size()) {
-                sprite.setTexture(ResourceManager::getTexture(
-                    deathImages[destroyFrameIdx++]));
+                ResourceManager::setSpriteTexture(
+                    sprite, deathImages[destroyFrameIdx++]);
                 deathTimer.restart();
             } else {
                 avail = false;
@@ -75,7 +69,7 @@ void Player::update(float deltaTime) {
     // Animation update
     if (animationTimer.hasElapsed(0.16f) && !dying) {
         current_texture = (current_texture + 1) % images.size();
-        sprite.setTexture(ResourceManager::getTexture(images[current_texture]));
+        ResourceManager::setSpriteTexture(sprite, images[current_texture]);
         animationTimer.restart();
     }
 
@@ -90,7 +84,7 @@ void Player::update(float deltaTime) {
         health = 0.0f;
         dying = true;
         destroyFrameIdx = 0;
-        sprite.setTexture(ResourceManager::getTexture(deathImages[0]));
+        ResourceManager::setSpriteTexture(sprite, deathImages[0]);
         deathTimer.restart();
     }
 
@@ -107,36 +101,38 @@ void Player::update(float deltaTime) {
     charming = isCharming;
     this->hasShield = hasShield;
 
-    if (hasShield)
-        shieldSprite.rotate(90.0f * deltaTime);
-}
-
-void Player::render(sf::RenderWindow &window) {
-    Entity::render(window);
     if (hasShield) {
         shieldSprite.setPosition(sprite.getPosition());
-        window.draw(shieldSprite);
+        shieldSprite.rotate(90.0f * deltaTime);
     }
 }
 
+void Player::render(sf::RenderWindow &window, float alpha) {
+    SpriteEntity::render(window, alpha);
+    if (hasShield)
+        drawInterpolated(window, shieldSprite, alpha);
+}
+
 void Player::move(float deltaTime) {
     auto [x, y] = sprite.getPosition();
 
     float realSpeed = speed * (1.0f + speedIncrease);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) && x > 0)
+    if (input.left && x > 0)
         sprite.move(-realSpeed * deltaTime, 0);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) &&
+    if (input.right &&
         x < Constants::SCREEN_WIDTH - sprite.getGlobalBounds().width)
         sprite.move(realSpeed * deltaTime, 0);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) && y > 0)
+    if (input.up && y > 0)
         sprite.move(0, -realSpeed * deltaTime);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) &&
+    if (input.down &&
         y < Constants::SCREEN_HEIGHT - sprite.getGlobalBounds().height)
         sprite.move(0, realSpeed * deltaTime);
 }
 
-void Player::updateCollisions(
-    std::vector<std::unique_ptr<Bullet>> &bullet_pool) {
+void Player::setInput(const PlayerInput &input) { this->input = input; }
+
+void Player::updateCollisions(BulletStore &bullet_pool,
+                              EffectSystem &effects) {
     if (!avail || dying)
         return;
 
@@ -144,67 +140,53 @@ void Player::updateCollisions(
         hasShield ? shieldSprite.getGlobalBounds() : getBounds();
 
     // Bullet collisions
-    for (auto &bullet : bullet_pool) {
-        if (bullet->isAvailable() && !bullet->from_player &&
-            bounds.intersects(bullet->getBounds())) {
-            takeDamage(std::max(bullet->damage, bullet->damageRate * health));
-            bullet->explode();
-            bullet->setAvailable(false);
-        }
-    }
+    bullet_pool.query(ColliderLayer::Player, bounds, [&](BulletRef bullet) {
+        takeDamage(
+            std::max(bullet.getDamage(), bullet.getDamageRate() * health));
+        bullet.explode(effects);
+        bullet.destroy();
+    });
 }
 
-void Player::shoot(std::vector<std::unique_ptr<Bullet>> &bullet_pool) {
+void Player::shoot(BulletStore &bullet_pool) {
     if (!avail)
         return;
 
-    bool shotSpeedIncreased = false;
-    if (current_shot_gap > 0.0f) {
-        float shot_gap = current_shot_gap;
-        float multiplier = 1.0f;
-        for (auto &gift : gifts)
-            multiplier *= (1.0f + gift->attackSpeedIncrease);
-        if (multiplier > 1.0f) {
-            shot_gap = current_shot_gap / multiplier;
-            shotSpeedIncreased = true;
-        }
-        if (!lastShotTimer.hasElapsed(shot_gap))
-            return;
-    }
-
-    const sf::Vector2f playerCenter = sprite.getPosition();
-    const float horizontalOffset = 20.0f;
-    const float verticalOffset = -16.0f;
-
-    // left
-    bullet_pool.push_back(std::make_unique<Cannon>(
-        playerCenter + sf::Vector2f(-horizontalOffset, verticalOffset),
-        sf::Vector2f(0.0f, -1.0f), Constants::PLAYER_BULLET_ID, true, 1024.0f,
-        damage, charming));
-
-    // right
-    bullet_pool.push_back(std::make_unique<Cannon>(
-        playerCenter + sf::Vector2f(horizontalOffset, verticalOffset),
-        sf::Vector2f(0.0f, -1.0f), Constants::PLAYER_BULLET_ID, true, 1024.0f,
-        damage, charming));
+    const bool shotSpeedIncreased = getShotMultiplier() > 1.0f;
+    Shooter shooter{sprite.getPosition(), 1024.0f, damage, true, charming};
+    bullet_pool.fire(Volleys::PLAYER_TWIN, shooter, random);
 
     static size_t counter = 0ul;
     if (shotSpeedIncreased) {
         if (counter % 2 == 0)
             ResourceManager::playSound("assets/bullet3.wav");
-        for (int i = 0; i < 6; i++) {
-            sf::Vector2f shootDirection =
-                sf::Vector2f(RandomUtils::generateInRange(-0.4f, 0.4f), -1.0f);
-            shootDirection = Math::normalize(shootDirection);
-            bullet_pool.push_back(std::make_unique<Cannon>(
-                playerCenter + sf::Vector2f(0.0f, verticalOffset * 2.0f),
-                shootDirection, Constants::PLAYER_SUPER_BULLET_ID, true,
-                1600.0f, damage, charming));
-        }
+        shooter.bulletSpeed = 1600.0f;
+        bullet_pool.fire(Volleys::PLAYER_SPRAY, shooter, random);
     }
     counter++;
+}
 
-    lastShotTimer.restart();
+void Player::startShooting(Scheduler &scheduler, BulletStore &bullet_pool) {
+    shotTask = scheduler.schedule(
+        current_shot_gap / getShotMultiplier(), [this, &bullet_pool] {
+            if (health > 0.0f)
+                shoot(bullet_pool);
+            return current_shot_gap / getShotMultiplier();
+        });
+}
+
+void Player::revive() {
+    avail = true;
+    dying = false;
+    health = Constants::PLAYER_MAX_HEALTH * 0.64f;
+    ResourceManager::setSpriteTexture(sprite, images[current_texture]);
+}
+
+float Player::getShotMultiplier() const {
+    float multiplier = 1.0f;
+    for (auto &gift : gifts)
+        multiplier *= (1.0f + gift->attackSpeedIncrease);
+    return multiplier;
 }
 
 void Player::takeDamage(float rawDamage) {
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 Nuo Shen, Nanjing University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Game/Benchmark.hpp"
+#include "Core/Constants.hpp"
+#include "Core/Math.hpp"
+#include "Core/ObjectPool.hpp"
+#include "Entities/BulletStore.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t BULLET_COUNT = 4096;
+constexpr int BULLET_ROUNDS = 64;
+constexpr int BULLET_TICKS = 16; // per round, before they leave the screen
+
+constexpr size_t STEER_COUNT = 4096;
+constexpr int STEER_ROUNDS = 1024;
+constexpr int ERROR_SAMPLES = 1 << 20;
+
+// Homing the way Missile and Rocket did it: through atan2, a wrapped angle
+// difference, then cos and sin
+sf::Vector2f steerByAngle(sf::Vector2f direction, sf::Vector2f target,
+                          float maxTurn) {
+    float currentAngle = Math::vectorToAngle(direction);
+    float targetAngle = Math::vectorToAngle(target);
+    float angleDiff = Math::normalizeAngle(targetAngle - currentAngle);
+    if (std::abs(angleDiff) > maxTurn)
+        angleDiff = (angleDiff > 0) ? maxTurn : -maxTurn;
+    return Math::angleToVector(currentAngle + angleDiff);
+}
+
+// A unit vector at a fixed pseudo-random angle
+Vec2 unitVector(size_t i) {
+    const float angle = (float)((i * 2654435761u) % 65536u) / 65536.0f;
+    return {std::cos(angle * 2.0f * Math::PI),
+            std::sin(angle * 2.0f * Math::PI)};
+}
+
+// Spread the bullets over the middle of the screen, aimed downwards
+sf::Vector2f spawnPosition(size_t i) {
+    return {200.0f + (float)(i % 64) * 16.0f, 200.0f + (float)(i / 64) * 8.0f};
+}
+
+template <typename F> double timeSeconds(F &&f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+} // namespace
+
+bool Benchmark::run(std::string_view name) {
+    if (name == "bullets")
+        bullets();
+    else if (name == "math")
+        math();
+    else
+        return false;
+    return true;
+}
+
+void Benchmark::bullets() {
+    const sf::Vector2f hitTarget(Constants::SCREEN_WIDTH / 2.0f,
+                                 Constants::SCREEN_HEIGHT);
+    const sf::Vector2f down(0.0f, 1.0f);
+
+    // Before: Missiles and Rockets interleaved behind Bullet pointers
+    using BulletPool = ObjectPool<Bullet, Missile, Rocket>;
+    BulletPool pool(BULLET_COUNT);
+    std::vector<BulletPool::Pointer> mixed;
+    mixed.reserve(BULLET_COUNT);
+    double virtualSeconds = 0.0;
+    for (int round = 0; round < BULLET_ROUNDS; round++) {
+        mixed.clear();
+        for (size_t i = 0; i < BULLET_COUNT; i++) {
+            if (i % 2 == 0)
+                mixed.push_back(pool.create<Missile>(
+                    spawnPosition(i), down, Constants::ENEMY_MISSILE_ID,
+                    false, 64.0f, 1.0f, 0.4f));
+            else
+                mixed.push_back(pool.create<Rocket>(spawnPosition(i), down,
+                                                    Constants::ENEMY_ROCKET_ID,
+                                                    false, 16.0f, 1.0f));
+        }
+        virtualSeconds += timeSeconds([&] {
+            for (int tick = 0; tick < BULLET_TICKS; tick++) {
+                for (auto &bullet : mixed) {
+                    bullet->storePreviousPosition();
+                    bullet->update(Constants::SIMULATION_TICK, hitTarget);
+                }
+            }
+        });
+    }
+    mixed.clear();
+
+    // After: the same bullets in a BulletStore
+    BulletPoolConfig config;
+    config.objectCapacity = BULLET_COUNT;
+    BulletStore store(config);
+    double bucketSeconds = 0.0;
+    size_t survivors = 0ul;
+    for (int round = 0; round < BULLET_ROUNDS; round++) {
+        store.clear();
+        for (size_t i = 0; i < BULLET_COUNT; i++) {
+            if (i % 2 == 0)
+                store.add<Missile>(spawnPosition(i), down,
+                                   Constants::ENEMY_MISSILE_ID, false, 64.0f,
+                                   1.0f, 0.4f);
+            else
+                store.add<Rocket>(spawnPosition(i), down,
+                                  Constants::ENEMY_ROCKET_ID, false, 16.0f,
+                                  1.0f);
+        }
+        bucketSeconds += timeSeconds([&] {
+            for (int tick = 0; tick < BULLET_TICKS; tick++)
+                store.update(Constants::SIMULATION_TICK, hitTarget);
+        });
+        survivors += store.size();
+    }
+
+    const double updates = (double)BULLET_COUNT * BULLET_ROUNDS * BULLET_TICKS;
+    // clang-format off
+    std::cout << "Bullet update benchmark: " << BULLET_COUNT
+              << " missiles and rockets, " << BULLET_ROUNDS << " rounds of "
+              << BULLET_TICKS << " ticks\n"
+              << "Virtual, interleaved: "
+              << virtualSeconds / updates * 1e9 << " ns/bullet\n"
+              << "Bucketed by type:     "
+              << bucketSeconds / updates * 1e9 << " ns/bullet\n"
+              << "Survivors: " << survivors / BULLET_ROUNDS << "\n"
+              << "Bytes per object: Missile " << sizeof(Missile)
+              << ", Rocket " << sizeof(Rocket) << std::endl;
+    // clang-format on
+}
+
+void Benchmark::math() {
+    // Largest errors over an even sweep of each input range, against the
+    // double precision functions
+    double rsqrtError = 0.0, atan2Error = 0.0, sinCosError = 0.0;
+    for (int i = 0; i < ERROR_SAMPLES; i++) {
+        const double t = (i + 0.5) / ERROR_SAMPLES;
+
+        const float x = (float)std::exp2(-20.0 + 40.0 * t);
+        const double exact = 1.0 / std::sqrt((double)x);
+        rsqrtError = std::max(rsqrtError,
+                              std::abs(Math::rsqrt(x) - exact) / exact);
+
+        const double turn = 2.0 * Math::PI * t;
+        const float cx = (float)std::cos(turn), cy = (float)std::sin(turn);
+        atan2Error = std::max(atan2Error,
+                              std::abs(Math::fastAtan2(cy, cx) -
+                                       std::atan2((double)cy, (double)cx)));
+
+        const float angle = (float)(-1000.0 + 2000.0 * t);
+        float sine, cosine;
+        Math::fastSinCos(angle, sine, cosine);
+        sinCosError = std::max(
+            {sinCosError, std::abs(sine - std::sin((double)angle)),
+             std::abs(cosine - std::cos((double)angle))});
+    }
+
+    // Each round turns every direction towards its target at the Missile
+    // turn rate; the targets rotate so that most turns are clamped
+    std::vector<sf::Vector2f> angleDirections(STEER_COUNT);
+    std::vector<Vec2> vectorDirections(STEER_COUNT), targets(STEER_COUNT);
+    for (size_t i = 0; i < STEER_COUNT; i++) {
+        angleDirections[i] = vectorDirections[i] = unitVector(i);
+        targets[i] = unitVector(i * 7 + 3);
+    }
+    const float maxTurn = 0.4f * Math::PI * Constants::SIMULATION_TICK;
+    const double angleSeconds = timeSeconds([&] {
+        for (int round = 0; round < STEER_ROUNDS; round++)
+            for (size_t i = 0; i < STEER_COUNT; i++)
+                angleDirections[i] =
+                    steerByAngle(angleDirections[i],
+                                 targets[(i + round) % STEER_COUNT], maxTurn);
+    });
+    const double vectorSeconds = timeSeconds([&] {
+        for (int round = 0; round < STEER_ROUNDS; round++)
+            for (size_t i = 0; i < STEER_COUNT; i++)
+                vectorDirections[i] =
+                    Math::steer(vectorDirections[i],
+                                targets[(i + round) % STEER_COUNT], maxTurn);
+    });
+    double drift = 0.0;
+    for (size_t i = 0; i < STEER_COUNT; i++)
+        drift = std::max(drift, (double)Math::distance(angleDirections[i],
+                                                       vectorDirections[i]));
+
+    const double steers = (double)STEER_COUNT * STEER_ROUNDS;
+    // clang-format off
+    std::cout << "Math benchmark\n"
+              << "rsqrt max relative error:     " << rsqrtError << "\n"
+              << "fastAtan2 max error:          " << atan2Error << " rad\n"
+              << "fastSinCos max error:         " << sinCosError << "\n"
+              << "Steering " << STEER_COUNT << " directions, "
+              << STEER_ROUNDS << " rounds\n"
+              << "Through angles: " << angleSeconds / steers * 1e9
+              << " ns/steer\n"
+              << "Math::steer:    " << vectorSeconds / steers * 1e9
+              << " ns/steer\n"
+              << "Largest difference in the end: " << drift << std::endl;
+    // clang-format on
+
+    std::string exceeded;
+    if (rsqrtError > Math::RSQRT_MAX_ERROR)
+        exceeded += " rsqrt";
+    if (atan2Error > Math::ATAN2_MAX_ERROR)
+        exceeded += " fastAtan2";
+    if (sinCosError > Math::SINCOS_MAX_ERROR)
+        exceeded += " fastSinCos";
+    if (!exceeded.empty())
+        throw std::runtime_error("Error bound exceeded by:" + exceeded);
+}
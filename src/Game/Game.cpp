@@ -16,17 +16,30 @@
 
 #include "Game/Game.hpp"
 #include "Core/Constants.hpp"
+#include "Core/GameClock.hpp"
 #include "Core/Logging.hpp"
 #include "Core/Macros.h"
 #include "Core/RandomUtils.hpp"
 #include "Core/ResourceManager.hpp"
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
-Game::Game(sf::RenderWindow &window)
-    : terminated(false), window(window), running(false) {
+Game::Game(sf::RenderWindow *window, const BulletPoolConfig &bulletConfig)
+    : terminated(false), window(window), bullets(bulletConfig),
+      running(false) {
+    std::fill(enemyCount.begin(), enemyCount.end(), 0);
+    player.startShooting(scheduler, bullets);
+    buildTickGraph();
+}
+
+Game::Game(const BulletPoolConfig &bulletConfig)
+    : Game(nullptr, bulletConfig) {}
+
+Game::Game(sf::RenderWindow &window) : Game(&window, BulletPoolConfig()) {
     backgroundSprite.setTexture(
         ResourceManager::getTexture(Constants::BACKGROUND_FILE_NAME));
     backgroundSprite.setPosition(0.0f, 0.0f);
@@ -97,8 +110,6 @@ Game::Game(sf::RenderWindow &window)
     exitText.setPosition(Constants::SCREEN_WIDTH / 2.0f,
                          saveText.getPosition().y + 80);
 
-    std::fill(enemyCount.begin(), enemyCount.end(), 0);
-
     // Determine file for saved progress
     static char path[SAVE_PATH_MAX];
     if (get_save_file_path(path))
@@ -106,16 +117,35 @@ Game::Game(sf::RenderWindow &window)
     save_file = path;
 }
 
+static PlayerInput readKeyboard() {
+    PlayerInput input;
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+    return input;
+}
+
+// Sweep the player from side to side so that a headless run keeps meeting
+// enemies and their bullets
+static PlayerInput autopilot(float timeElapsed) {
+    PlayerInput input;
+    input.right = std::fmod(timeElapsed, 4.0f) < 2.0f;
+    input.left = !input.right;
+    return input;
+}
+
 void Game::run() {
     running = true;
     paused = false;
-    deltaTimer.restart();
+    frameClock.restart();
+    tickAccumulator = 0.0f;
 
     sf::Event event;
-    while (running && window.isOpen()) {
-        while (running && window.pollEvent(event)) {
+    while (running && window->isOpen()) {
+        while (running && window->pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
-                window.close();
+                window->close();
                 terminated = true;
                 break;
             } else if (event.type == sf::Event::KeyPressed) {
@@ -129,7 +159,7 @@ void Game::run() {
                                    .getStatus() != sf::SoundSource::Playing) {
                         ResourceManager::gameBackgroundMusic.play();
                     }
-                    deltaTimer.restart();
+                    frameClock.restart();
                 } else if (event.key.code == sf::Keyboard::Escape) {
                     running = false;
                     break;
@@ -153,7 +183,7 @@ void Game::run() {
                             switch (currentPauseOption) {
                                 case PAUSE_OPTION_RESUME:
                                     paused = false;
-                                    deltaTimer.restart();
+                                    frameClock.restart();
                                     break;
                                 case PAUSE_OPTION_SAVE: saveToDisk(); break;
                                 case PAUSE_OPTION_EXIT: running = false; break;
@@ -169,78 +199,160 @@ void Game::run() {
             break;
 
         if (paused) {
-            deltaTimer.restart();
+            frameClock.restart();
             showingInstructions = true;
         } else {
-            float deltaTime = deltaTimer.getElapsedTime();
-            deltaTimer.restart();
-            if (!update(deltaTime))
+            // Advance the simulation in fixed steps and carry the remainder
+            // over to the next frame. Clamp the frame time so that a stall
+            // does not turn into an unbounded burst of catch-up ticks.
+            float frameTime = std::min(frameClock.restart().asSeconds(),
+                                       Constants::MAX_FRAME_TIME);
+            tickAccumulator += frameTime;
+
+            player.setInput(readKeyboard());
+
+            bool alive = true;
+            while (tickAccumulator >= Constants::SIMULATION_TICK) {
+                tickAccumulator -= Constants::SIMULATION_TICK;
+                if (!update(Constants::SIMULATION_TICK)) {
+                    alive = false;
+                    break;
+                }
+            }
+            if (!alive)
                 break;
+            effects.update(frameTime);
+            renderAlpha = tickAccumulator / Constants::SIMULATION_TICK;
         }
 
-        render();
+        updateHud();
+        render(renderAlpha);
     }
     running = false;
+
+    if (renderedFrames > 0ul) {
+        // Each batched sprite used to be a draw call of its own
+        const SpriteBatch::Stats &batched = spriteBatch.getStats();
+        LOG_INFO("Draw calls per frame: "
+                 << batched.sprites / renderedFrames << " unbatched, "
+                 << batched.drawCalls / renderedFrames << " batched");
+        // Each request used to be a full-screen fill of its own
+        const ScreenEffects::Stats &screen = screenEffects.getStats();
+        LOG_INFO("Full-screen layers: " << screen.requests << " requested, "
+                                        << screen.layers << " drawn");
+        LOG_INFO("Effects dropped by full pools: "
+                 << effects.getDroppedCount());
+    }
+}
+
+SimulationStats Game::runHeadless(size_t maxTicks, double maxSeconds) {
+    using clock = std::chrono::steady_clock;
+
+    SimulationStats stats;
+    running = true;
+    const clock::time_point start = clock::now();
+    auto wallSeconds = [&start] {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    while (running) {
+        if (maxTicks > 0ul && stats.ticks >= maxTicks)
+            break;
+        if (maxSeconds > 0.0 && wallSeconds() >= maxSeconds)
+            break;
+
+        player.setInput(autopilot(timeElapsed));
+        if (!update(Constants::SIMULATION_TICK)) {
+            // The tick did not run, so it is not counted
+            stats.playerDeaths++;
+            player.revive();
+            continue;
+        }
+        stats.ticks++;
+        stats.peakBullets = std::max(stats.peakBullets, bullets.size());
+        stats.peakEnemies = std::max(stats.peakEnemies, enemies.size());
+    }
+    running = false;
+
+    stats.wallSeconds = wallSeconds();
+    stats.simulatedSeconds = timeElapsed;
+    stats.bullets = bullets.size();
+    stats.enemies = enemies.size();
+    stats.gifts = player.gifts.size();
+    stats.killed = killed;
+    stats.scheduledEvents = scheduler.getFiredCount();
+    stats.droppedBullets = bullets.getDroppedCount();
+    stats.collisionCandidates = bullets.getCandidateCount();
+    stats.collisionHits = bullets.getHitCount();
+    stats.workers = jobs.getWorkerCount();
+    stats.seed = RandomUtils::getSeed();
+    stats.taskTimings = tickGraph.getTimings();
+    return stats;
 }
 
 void Game::bringGifts() {
+    // FullFirePower, CenturyShield, AllMyPeople, SpeedStorm
+    static constexpr AliasTable<4> giftTable({20.0f, 25.0f, 15.0f, 40.0f});
     if (player.gifts.size() >= 3ul)
         return;
 
     if (giftTimer.hasElapsed(Constants::GIFT_SPAWN_INTERVAL) &&
-        RandomUtils::chooseWithProb(Constants::GIFT_SPAWN_PROBABILITY)) {
+        RandomUtils::chooseWithProb(giftRandom,
+                                    Constants::GIFT_SPAWN_PROBABILITY)) {
         int count = RandomUtils::chooseWithProb(
-                        Constants::GIFT_SPAWN_PROBABILITY / 2.0f)
-                        ? (currentBoss ? 3 : 2)
+                        giftRandom, Constants::GIFT_SPAWN_PROBABILITY / 2.0f)
+                        ? (getBoss() ? 3 : 2)
                         : 1;
-        std::vector<int> choices = {0, 1, 2, 3};
-        std::vector<float> ratios = {20.0f, 25.0f, 15.0f, 40.0f};
+        // Each gift is brought at most once
+        AliasTable<4> gifts = giftTable;
         for (int i = 0; i < count; i++) {
-            int choice = RandomUtils::generateFromSetWithRatio(choices, ratios);
+            const size_t choice = gifts.sample(giftRandom);
             switch (choice) {
                 case 0:
-                    player.gifts.push_back(std::make_unique<FullFirePower>());
+                    addGift(std::make_unique<FullFirePower>(giftRandom));
                     break;
                 case 1:
-                    player.gifts.push_back(std::make_unique<CenturyShield>());
+                    addGift(std::make_unique<CenturyShield>(giftRandom));
                     break;
                 case 2:
-                    player.gifts.push_back(std::make_unique<AllMyPeople>());
+                    addGift(std::make_unique<AllMyPeople>(giftRandom));
                     break;
                 case 3:
-                    player.gifts.push_back(std::make_unique<SpeedStorm>());
+                    addGift(std::make_unique<SpeedStorm>(giftRandom));
                     break;
                 default: __unreachable(); break;
             }
-            for (int i = 0; i < choices.size(); i++)
-                if (choice == choices[i])
-                    ratios[i] = 0.0f;
+            gifts.setWeight(choice, 0.0f);
         }
         giftTimer.restart();
     }
 }
 
 void Game::spawnEnemies() {
-    static const std::vector<int> levelSet = {1, 2, 3};
-    static const std::vector<float> levelProb = {Constants::ENEMY1_SPAWN_PROB,
-                                                 Constants::ENEMY2_SPAWN_PROB,
-                                                 Constants::ENEMY3_SPAWN_PROB};
-    float spawnInterval = currentBoss ? 0.1f : 0.6f;
+    // Indexed by level - 1
+    static constexpr AliasTable<3> levelTable({Constants::ENEMY1_SPAWN_PROB,
+                                               Constants::ENEMY2_SPAWN_PROB,
+                                               Constants::ENEMY3_SPAWN_PROB});
+    // Anywhere along the top of the screen
+    auto randomX = [this] {
+        return (float)RandomUtils::generateInRange(
+            spawnRandom, 0, Constants::SCREEN_WIDTH - 1);
+    };
+    drainSpawnQueue();
+
+    float spawnInterval = getBoss() ? 0.1f : 0.6f;
     if (spawnTimer.hasElapsed(spawnInterval)) {
-        int enemyLevel =
-            RandomUtils::generateFromSetWithProb(levelSet, levelProb);
+        int enemyLevel = (int)levelTable.sample(spawnRandom) + 1;
         switch (enemyLevel) {
             case 1:
                 if (enemyCount[1] < Constants::ENEMY1_MAX_ALIVE) {
-                    enemies.push_back(std::make_unique<Enemy1>(
-                        sf::Vector2f(rand() % Constants::SCREEN_WIDTH, 0)));
+                    addEnemy(1, sf::Vector2f(randomX(), 0));
                     enemyCount[1]++;
                 }
                 break;
             case 2:
                 if (enemyCount[2] < Constants::ENEMY2_MAX_ALIVE) {
-                    enemies.push_back(std::make_unique<Enemy2>(
-                        sf::Vector2f(rand() % Constants::SCREEN_WIDTH, 0)));
+                    addEnemy(2, sf::Vector2f(randomX(), 0));
                     enemyCount[2]++;
                 }
                 break;
@@ -249,17 +361,15 @@ void Game::spawnEnemies() {
                     timeElapsed > 32.0f) {
                     // Spawn 32 enemy1
                     for (int i = 0; i < 32; i++)
-                        enemies.push_back(std::make_unique<Enemy1>(
-                            sf::Vector2f(rand() % Constants::SCREEN_WIDTH, 0)));
+                        queueEnemy(1, sf::Vector2f(randomX(), 0));
 
                     // Spawn 24 enemy2
                     for (int i = 0; i < 24; i++)
-                        enemies.push_back(std::make_unique<Enemy2>(
-                            sf::Vector2f(rand() % Constants::SCREEN_WIDTH, 0)));
+                        queueEnemy(2, sf::Vector2f(randomX(), 0));
 
                     // Spawn 1 enemy3
-                    enemies.push_back(std::make_unique<Enemy3>(
-                        sf::Vector2f(Constants::SCREEN_WIDTH / 2.0f, 0)));
+                    queueEnemy(3,
+                               sf::Vector2f(Constants::SCREEN_WIDTH / 2.0f, 0));
                     enemyCount[1] += 32;
                     enemyCount[2] += 24;
                     enemyCount[3] += 1;
@@ -271,26 +381,55 @@ void Game::spawnEnemies() {
     }
 }
 
+void Game::addEnemy(int level, sf::Vector2f position) {
+    EnemyHandle enemy = enemies.spawn(level, position);
+    if (level == 3)
+        currentBoss = enemy;
+}
+
+void Game::queueEnemy(int level, sf::Vector2f position) {
+    spawnQueue.push_back({level, position});
+}
+
+void Game::drainSpawnQueue() {
+    for (size_t i = 0; i < Constants::ENEMY_SPAWN_BUDGET && !spawnQueue.empty();
+         i++) {
+        addEnemy(spawnQueue.front().level, spawnQueue.front().position);
+        spawnQueue.pop_front();
+    }
+}
+
+void Game::addGift(std::unique_ptr<Gift> gift) {
+    gift->startCountdown(scheduler);
+    player.gifts.insert(std::move(gift));
+}
+
+const Vitals *Game::getBoss() const {
+    const Vitals *boss = enemies.getVitals(currentBoss);
+    return boss && boss->health > 0.0f ? boss : nullptr;
+}
+
 bool Game::isRunning() { return running; }
 
 boost::json::object Game::serialize() const {
-    boost::json::object o = {{"deltaTime", deltaTimer.getElapsedTime()},
-                             {"giftTime", giftTimer.getElapsedTime()},
+    boost::json::object o = {{"giftTime", giftTimer.getElapsedTime()},
                              {"spawnTime", spawnTimer.getElapsedTime()},
                              {"timeElapsed", timeElapsed},
                              {"killed", killed}};
 
     // bullets
-    boost::json::array bulletsArray;
-    for (const auto &bullet : bullets)
-        bulletsArray.push_back(bullet->serialize());
-    o["bullets"] = std::move(bulletsArray);
+    o["bullets"] = bullets.serialize();
 
     // enemies
-    boost::json::array enemiesArray;
-    for (const auto &enemy : enemies)
-        enemiesArray.push_back(enemy->serialize());
-    o["enemies"] = std::move(enemiesArray);
+    o["enemies"] = enemies.serialize();
+
+    boost::json::array pendingArray;
+    for (const PendingSpawn &pending : spawnQueue)
+        pendingArray.push_back(
+            {{"level", pending.level},
+             {"position",
+              {{"x", pending.position.x}, {"y", pending.position.y}}}});
+    o["pendingEnemies"] = std::move(pendingArray);
 
     // enemyCount will be deduced from enemies
 
@@ -307,12 +446,13 @@ boost::json::object Game::serialize() const {
 }
 
 void Game::deserialize(const boost::json::object &o) {
-    deltaTimer.setElapsedTime((float)o.at("deltaTime").as_double());
     giftTimer.setElapsedTime((float)o.at("giftTime").as_double());
     spawnTimer.setElapsedTime((float)o.at("spawnTime").as_double());
     timeElapsed = (float)o.at("timeElapsed").as_double();
     killed = (size_t)o.at("killed").as_int64();
 
+    effects.clear();
+
     // bullets
     bullets.clear();
     for (const auto &v : o.at("bullets").as_array()) {
@@ -322,11 +462,11 @@ void Game::deserialize(const boost::json::object &o) {
             continue;
         std::string type = obj.at("type").as_string().c_str();
         if (type == "Cannon")
-            bullets.push_back(std::make_unique<Cannon>(obj));
+            bullets.addCannon(obj);
         else if (type == "Missile")
-            bullets.push_back(std::make_unique<Missile>(obj));
+            bullets.add<Missile>(obj);
         else if (type == "Rocket")
-            bullets.push_back(std::make_unique<Rocket>(obj));
+            bullets.add<Rocket>(obj);
         else
             LOG_WARN("Unrecognized bullet type: " << type);
     }
@@ -340,16 +480,34 @@ void Game::deserialize(const boost::json::object &o) {
         if (!avail)
             continue;
         int level = (int)obj.at("level").as_int64();
-        switch (level) {
-            case 1: enemies.push_back(std::make_unique<Enemy1>(obj)); break;
-            case 2: enemies.push_back(std::make_unique<Enemy2>(obj)); break;
-            case 3: enemies.push_back(std::make_unique<Enemy3>(obj)); break;
-            default: LOG_WARN("Unrecognized enemy level: " << level); break;
+        if (level < 1 || level > (int)Constants::ENEMY_LEVEL_COUNT) {
+            LOG_WARN("Unrecognized enemy level: " << level);
+            continue;
+        }
+        EnemyHandle enemy = enemies.spawn(obj);
+        if (level == 3)
+            currentBoss = enemy;
+    }
+    for (int level = 1; level <= (int)Constants::ENEMY_LEVEL_COUNT; level++)
+        enemyCount[level] = enemies.countHostile(level);
+
+    // Saves from before the spawn queue have no pending enemies
+    spawnQueue.clear();
+    if (const boost::json::value *pending = o.if_contains("pendingEnemies")) {
+        for (const auto &v : pending->as_array()) {
+            auto obj = v.as_object();
+            int level = (int)obj.at("level").as_int64();
+            if (level < 1 || level > (int)Constants::ENEMY_LEVEL_COUNT) {
+                LOG_WARN("Unrecognized enemy level: " << level);
+                continue;
+            }
+            auto position_obj = obj.at("position").as_object();
+            sf::Vector2f position((float)position_obj.at("x").as_double(),
+                                  (float)position_obj.at("y").as_double());
+            queueEnemy(level, position);
+            enemyCount[level]++;
         }
     }
-    for (const auto &enemy : enemies)
-        if (enemy->isAvailable() && !enemy->charmed)
-            enemyCount[enemy->level]++;
 
     // player
     player.deserialize(o.at("player").as_object());
@@ -362,13 +520,13 @@ void Game::deserialize(const boost::json::object &o) {
             continue;
         std::string name = obj.at("name").as_string().c_str();
         if (name == "FullFirePower")
-            player.gifts.push_back(std::make_unique<FullFirePower>(obj));
+            addGift(std::make_unique<FullFirePower>(obj));
         else if (name == "CenturyShield")
-            player.gifts.push_back(std::make_unique<CenturyShield>(obj));
+            addGift(std::make_unique<CenturyShield>(obj));
         else if (name == "AllMyPeople")
-            player.gifts.push_back(std::make_unique<AllMyPeople>(obj));
+            addGift(std::make_unique<AllMyPeople>(obj));
         else if (name == "SpeedStorm")
-            player.gifts.push_back(std::make_unique<SpeedStorm>(obj));
+            addGift(std::make_unique<SpeedStorm>(obj));
         else
             LOG_WARN("Unrecognized gift name: " << name);
     }
@@ -406,6 +564,9 @@ void Game::saveToDisk() {
 
 bool Game::update(float deltaTime) {
     if (!player.isAvailable()) {
+        if (!window)
+            return false;
+
         gameOverText.setFont(ResourceManager::gameFont);
         gameOverText.setString("GAME OVER");
         gameOverText.setCharacterSize(80);
@@ -414,29 +575,100 @@ bool Game::update(float deltaTime) {
                                      gameOverText.getGlobalBounds().width / 2,
                                  (float)Constants::SCREEN_HEIGHT / 2 -
                                      gameOverText.getGlobalBounds().height / 2);
-        window.draw(gameOverText);
-        window.display();
+        window->draw(gameOverText);
+        window->display();
 
-        Timer waitTimer;
-        while (!waitTimer.hasElapsed(3.2f))
-            ;
+        sf::sleep(sf::seconds(3.2f));
         return false;
     }
 
-    player.update(deltaTime);
-    player.updateCollisions(bullets);
+    tickDelta = deltaTime;
+    tickGraph.run(jobs);
+    return true;
+}
 
+// The scheduler, the sounds, the random generators, the bullet store and
+// the effects are shared by most steps, so those run one after another in
+// the order of the old serial tick. Enemy movement only touches enemy
+// columns and overlaps the bullet steps.
+void Game::buildTickGraph() {
+    using Task = TaskGraph::TaskId;
+    TaskGraph &g = tickGraph;
+
+    const Task clock = g.add("clock", [this] {
+        GameClock::advance(tickDelta);
+        timeElapsed += tickDelta;
+        enemyReport = {};
+    });
+    const Task playerMove = g.add(
+        "player",
+        [this] {
+            player.storePreviousPosition();
+            player.update(tickDelta);
+        },
+        {clock});
+    // Run the shots, gift countdowns and explosions that are due
+    const Task timers =
+        g.add("scheduler", [this] { scheduler.advance(); }, {playerMove});
+    // Hit the strongest charmed enemy
+    const Task target = g.add(
+        "target",
+        [this] {
+            hitTarget = player.getPosition();
+            enemies.findStrongestCharmed(hitTarget);
+        },
+        {timers});
+    const Task sweep = g.add(
+        "enemy sweep", [this] { enemies.removeDeparted(enemyReport); },
+        {target});
+    const Task enemyMove =
+        g.add("enemy move", [this] { enemies.move(tickDelta); }, {sweep});
+
+    const Task bulletMove = g.add(
+        "bullets", [this] { bullets.update(tickDelta, hitTarget); },
+        {sweep});
+    // Bucket the bullets once, then let every collider query nearby ones
+    const Task grids =
+        g.add("grids", [this] { bullets.rebuildGrids(); }, {bulletMove});
+    const Task playerHits = g.add(
+        "player hits",
+        [this] { player.updateCollisions(bullets, effects); }, {grids});
+    // Drop expired gifts
+    const Task giftExpiry = g.add(
+        "gift expiry",
+        [this] {
+            player.gifts.eraseIf(
+                [](const auto &gift) { return !gift->isAvailable(); });
+        },
+        {playerHits});
+
+    const Task enemyHits = g.add(
+        "enemy hits", [this] { enemies.collide(tickDelta, enemyReport); },
+        {enemyMove, giftExpiry});
+    const Task score = g.add(
+        "score",
+        [this] {
+            player.health += enemyReport.bonus;
+            killed += enemyReport.killed;
+            for (size_t level = 1; level < enemyCount.size(); level++)
+                enemyCount[level] = std::max(
+                    0, enemyCount[level] - enemyReport.departed[level]);
+        },
+        {enemyHits});
+    const Task spawn = g.add("spawn", [this] { spawnEnemies(); }, {score});
+    g.add("gift drops", [this] { bringGifts(); }, {spawn});
+}
+
+void Game::updateHud() {
     std::ostringstream oss;
 
     if (!paused) {
-        timeElapsed += deltaTime;
         oss << "Time: " << std::fixed << std::setprecision(3) << timeElapsed
             << 's';
         stopwatchText.setString(oss.str());
+        showingInstructions = (timeElapsed <= 8.0f);
     }
 
-    showingInstructions = (timeElapsed <= 8.0f);
-
     oss.clear();
     oss.str("");
     oss << "Health: " << std::fixed << std::setprecision(2) << player.health;
@@ -447,113 +679,46 @@ bool Game::update(float deltaTime) {
     oss << "killed: " << killed;
     killedText.setString(oss.str());
 
-    if (player.health > 0.0f)
-        player.shoot(bullets);
-
-    // Update bullets
-    sf::Vector2f hitTarget = player.getPosition();
-    // Hit the strongest charmed enemy
-    float maxCharmedHealth = 0.0f;
-    for (const auto &enemy : enemies) {
-        if (enemy->isAvailable() && enemy->charmed &&
-            enemy->health > maxCharmedHealth) {
-            hitTarget = enemy->getPosition();
-            maxCharmedHealth = enemy->health;
-        }
-    }
-    for (auto it = bullets.begin(); it != bullets.end();) {
-        if ((*it)->isAvailable()) {
-            (*it)->update(deltaTime, hitTarget);
-            ++it;
-        } else {
-            if (!(*it)->exploding)
-                bullets.erase(it);
-            else
-                ++it;
-        }
-    }
-
-    // Update gifts
-    for (auto it = player.gifts.begin(); it != player.gifts.end();) {
-        if ((*it)->isAvailable()) {
-            (*it)->update(deltaTime);
-            ++it;
-        } else {
-            player.gifts.erase(it);
-        }
-    }
-
-    // Update enemies
-    currentBoss = nullptr;
-    for (auto it = enemies.begin(); it != enemies.end();) {
-        int level = (*it)->level;
-        if ((*it)->isAvailable()) {
-            (*it)->update(deltaTime);
-            (*it)->shoot(bullets);
-            (*it)->updateBulletCollisions(bullets);
-            if (!(*it)->bonusTaken && (*it)->charmed) {
-                player.health += (*it)->killBonus;
-                killed++;
-                enemyCount[level] = std::max(0, enemyCount[level] - 1);
-                (*it)->bonusTaken = true;
-            } else if ((*it)->level == 3 && (*it)->health > 0.0f)
-                currentBoss = it->get();
-            ++it;
-        } else {
-            if (!(*it)->bonusTaken && (*it)->health <= 0.0f) {
-                player.health += (*it)->killBonus;
-                killed++;
-                (*it)->bonusTaken = true;
-            }
-            enemyCount[level] = std::max(0, enemyCount[level] - 1);
-            enemies.erase(it);
-        }
-    }
-    if (currentBoss) {
+    if (const Vitals *boss = getBoss()) {
         oss.clear();
         oss.str("");
-        oss << "Boss: " << (int)currentBoss->health << std::endl
+        oss << "Boss: " << (int)boss->health << std::endl
             << std::fixed << std::setprecision(5)
-            << currentBoss->health / currentBoss->maxHealth * 100 << '%';
+            << boss->health / boss->maxHealth * 100 << '%';
         bossHealthText.setString(oss.str());
     }
-
-    spawnEnemies();
-    bringGifts();
-    return true;
 }
 
-void Game::render() {
-    window.clear();
+void Game::render(float alpha) {
+    window->clear();
 
     if (player.charming)
         backgroundSprite.setColor(sf::Color(244, 154, 240, 232));
     else
         backgroundSprite.setColor(sf::Color::White);
-    window.draw(backgroundSprite);
+    window->draw(backgroundSprite);
 
-    player.render(window);
+    player.render(*window, alpha);
 
-    for (auto &bullet : bullets)
-        bullet->render(window);
+    bullets.render(*window, spriteBatch, alpha);
+    effects.render(*window, spriteBatch, screenEffects);
 
-    for (auto &enemy : enemies)
-        if (enemy->isAvailable())
-            enemy->render(window);
+    enemies.render(*window, spriteBatch, alpha);
+    renderedFrames++;
 
-    window.draw(stopwatchText);
-    window.draw(healthText);
-    window.draw(killedText);
-    if (currentBoss)
-        window.draw(bossHealthText);
+    window->draw(stopwatchText);
+    window->draw(healthText);
+    window->draw(killedText);
+    if (getBoss())
+        window->draw(bossHealthText);
     drawGifts();
 
     if (paused) {
         sf::RectangleShape overlay(
             sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
         overlay.setFillColor(sf::Color(0, 0, 0, 150));
-        window.draw(overlay);
-        window.draw(pauseText);
+        window->draw(overlay);
+        window->draw(pauseText);
 
         resumeText.setFillColor(currentPauseOption == PAUSE_OPTION_RESUME
                                     ? sf::Color::Blue
@@ -564,15 +729,15 @@ void Game::render() {
         exitText.setFillColor(currentPauseOption == PAUSE_OPTION_EXIT
                                   ? sf::Color::Red
                                   : sf::Color::White);
-        window.draw(resumeText);
-        window.draw(saveText);
-        window.draw(exitText);
+        window->draw(resumeText);
+        window->draw(saveText);
+        window->draw(exitText);
     }
 
     if (showingInstructions)
-        window.draw(instructionText);
+        window->draw(instructionText);
 
-    window.display();
+    window->display();
 }
 
 void Game::drawGifts() {
@@ -588,7 +753,7 @@ void Game::drawGifts() {
     float baseY = Constants::SCREEN_HEIGHT - iconSize - padding - 40;
 
     for (size_t i = 0; i < player.gifts.size(); ++i) {
-        auto &gift = player.gifts[i];
+        const auto &gift = player.gifts[i];
 
         float x = startX + i * (iconSize + spacing);
         float y = baseY;
@@ -598,12 +763,12 @@ void Game::drawGifts() {
         background.setFillColor(sf::Color(0, 0, 0, 120));
         background.setOutlineThickness(2.0f);
         background.setOutlineColor(sf::Color(255, 255, 255, 180));
-        window.draw(background);
+        window->draw(background);
 
         // Icon
         sf::Sprite icon = gift->getSprite();
         icon.setPosition(x, y);
-        window.draw(icon);
+        window->draw(icon);
 
         // Timer
         float remaining = gift->getRemainingTime();
@@ -627,7 +792,7 @@ void Game::drawGifts() {
         float textX = x + (iconSize - textBounds.width) / 2.0f;
         float textY = y + iconSize + textGap;
         text.setPosition(textX, textY);
-        window.draw(text);
+        window->draw(text);
 
         // Flash
         if (remaining < 3.0f) {
@@ -640,7 +805,7 @@ void Game::drawGifts() {
                 alertOverlay.setSize(sf::Vector2f(iconSize, iconSize));
                 alertOverlay.setPosition(x, y);
                 alertOverlay.setFillColor(sf::Color(255, 100, 100, 80));
-                window.draw(alertOverlay);
+                window->draw(alertOverlay);
             }
         }
 
@@ -652,7 +817,7 @@ void Game::drawGifts() {
             progressBg.setSize(sf::Vector2f(iconSize, 4));
             progressBg.setPosition(x, y + iconSize + 2);
             progressBg.setFillColor(sf::Color(50, 50, 50, 200));
-            window.draw(progressBg);
+            window->draw(progressBg);
 
             sf::RectangleShape progressBar;
             progressBar.setSize(sf::Vector2f(iconSize * progress, 4));
@@ -665,7 +830,7 @@ void Game::drawGifts() {
             } else {
                 progressBar.setFillColor(sf::Color::Green);
             }
-            window.draw(progressBar);
+            window->draw(progressBar);
         }
     }
 }
@@ -17,6 +17,7 @@
 #include "Game/Menu.hpp"
 #include "Core/Constants.hpp"
 #include "Core/Macros.h"
+#include "Core/RandomUtils.hpp"
 #include "Core/ResourceManager.hpp"
 #include <SFML/Config.hpp>
 #include <SFML/Graphics/Color.hpp>
@@ -27,6 +28,7 @@ Menu::Menu()
     : window(sf::VideoMode(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT),
              "Thunder Wings"),
       active(false) {
+    ResourceManager::buildAtlas(Constants::ASSETS_DIRECTORY);
     backgroundSprite.setTexture(
         ResourceManager::getTexture(Constants::BACKGROUND_FILE_NAME));
     backgroundSprite.setPosition(0.0f, 0.0f);
@@ -115,7 +117,7 @@ void Menu::playLogo() {
             }
         }
 
-        float elapsed = logoClock.getElapsedTime();
+        float elapsed = logoClock.getElapsedTime().asSeconds();
         float progress = elapsed / Constants::LOGO_DURATION;
 
         if (progress < 1.0f) {
@@ -221,6 +223,7 @@ void Menu::render() {
 
 void Menu::start() {
     active = false;
+    RandomUtils::reseed();
     game = std::make_unique<Game>(window);
     game->run();
     if (game->terminated)
@@ -230,6 +233,7 @@ void Menu::start() {
 }
 
 void Menu::load() {
+    RandomUtils::reseed();
     game = std::make_unique<Game>(window);
     game->loadFromDisk();
     game->run();
@@ -14,9 +14,16 @@
  * limitations under the License.
  */
 
+#include "Core/Constants.hpp"
+#include "Core/CpuDispatch.hpp"
+#include "Core/JobSystem.hpp"
 #include "Core/Logging.hpp"
+#include "Core/RandomUtils.hpp"
 #include "Core/ResourceManager.hpp"
+#include "Game/Benchmark.hpp"
 #include "Game/Menu.hpp"
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
 
 static inline void printVersion() {
@@ -32,21 +39,138 @@ static inline void printVersion() {
     // clang-format on
 }
 
+static inline void printUsage() {
+    // clang-format off
+    std::cout << "Usage: thunder_wings [options]\n"
+              << "  -v, --version      Print version and exit\n"
+              << "  -h, --help         Print this help and exit\n"
+              << "  --headless         Run the simulation without a window\n"
+              << "  --ticks N          Headless: stop after N ticks\n"
+              << "  --seconds S        Headless: stop after S seconds\n"
+              << "  --bullet-capacity N\n"
+              << "                     Headless: live straight-line bullets\n"
+              << "  --overflow POLICY  Headless: drop-newest, drop-oldest or\n"
+              << "                     refuse-hostile (default)\n"
+              << "  --workers N        Use at most N worker threads\n"
+              << "  --scalar           Use the scalar kernels, not SIMD ones\n"
+              << "  --seed N           Seed the random numbers, so that runs\n"
+              << "                     repeat\n"
+              << "  --bench NAME       Run a micro-benchmark and exit\n"
+              << "                     (bullets, math)\n"
+              << std::endl;
+    // clang-format on
+}
+
+static inline void printStats(const SimulationStats &stats) {
+    double ticksPerSecond =
+        stats.wallSeconds > 0.0 ? stats.ticks / stats.wallSeconds : 0.0;
+    // clang-format off
+    std::cout << "Headless run finished\n"
+              << "Ticks: " << stats.ticks << "\n"
+              << "Wall time: " << stats.wallSeconds << "s\n"
+              << "Simulated time: " << stats.simulatedSeconds << "s\n"
+              << "Ticks/sec: " << ticksPerSecond << "\n"
+              << "Bullets: " << stats.bullets
+              << " (peak " << stats.peakBullets << ")\n"
+              << "Enemies: " << stats.enemies
+              << " (peak " << stats.peakEnemies << ")\n"
+              << "Gifts: " << stats.gifts << "\n"
+              << "Killed: " << stats.killed << "\n"
+              << "Scheduled events: " << stats.scheduledEvents << "\n"
+              << "Dropped bullets: " << stats.droppedBullets << "\n"
+              << "Collision candidates: " << stats.collisionCandidates
+              << " (hits " << stats.collisionHits << ")\n"
+              << "Player deaths: " << stats.playerDeaths << "\n"
+              << "Seed: " << stats.seed << "\n"
+              << "Workers: " << stats.workers << "\n"
+              << "Tick tasks (mean us per tick):\n";
+    // clang-format on
+    for (const auto &task : stats.taskTimings) {
+        const double micros =
+            task.runs > 0ul ? task.seconds * 1e6 / task.runs : 0.0;
+        std::cout << "  " << std::left << std::setw(14) << task.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << micros << "\n";
+    }
+    std::cout << std::defaultfloat << std::flush;
+}
+
 int main(int argc, char *argv[]) {
     printVersion();
-    if (argc > 1) {
-        std::string_view arg = argv[1];
-        if (arg == "--version" || arg == "-v")
+
+    bool headless = false;
+    bool forceScalar = false;
+    std::string_view benchmark;
+    size_t maxTicks = 0ul;
+    double maxSeconds = 0.0;
+    BulletPoolConfig bulletConfig;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--version" || arg == "-v") {
+            return EXIT_SUCCESS;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
             return EXIT_SUCCESS;
+        } else if (arg == "--bench" && i + 1 < argc) {
+            benchmark = argv[++i];
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            maxTicks = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            maxSeconds = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            JobSystem::setWorkerLimit(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--scalar") {
+            forceScalar = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            RandomUtils::setSeed(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--bullet-capacity" && i + 1 < argc) {
+            bulletConfig.capacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--overflow" && i + 1 < argc) {
+            std::string_view policy = argv[++i];
+            if (policy == "drop-newest") {
+                bulletConfig.policy = OverflowPolicy::DropNewest;
+            } else if (policy == "drop-oldest") {
+                bulletConfig.policy = OverflowPolicy::DropOldest;
+            } else if (policy == "refuse-hostile") {
+                bulletConfig.policy = OverflowPolicy::RefuseHostileFirst;
+            } else {
+                std::cerr << "Unknown overflow policy: " << policy << std::endl;
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return EXIT_FAILURE;
+        }
     }
+    // One minute of simulated time unless told otherwise
+    if (headless && maxTicks == 0ul && maxSeconds <= 0.0)
+        maxTicks = (size_t)(60.0f * Constants::SIMULATION_TICK_RATE);
 
     logging::init();
     LOG_INFO("Welcome!");
+    LOG_INFO("Random seed: " << RandomUtils::getSeed());
+    CpuDispatch::init(forceScalar);
 
     try {
-        Menu menu;
-        menu.playLogo();
-        menu.show();
+        if (!benchmark.empty()) {
+            ResourceManager::setHeadless(true);
+            if (!Benchmark::run(benchmark)) {
+                std::cerr << "Unknown benchmark: " << benchmark << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if (headless) {
+            ResourceManager::setHeadless(true);
+            Game game(bulletConfig);
+            printStats(game.runHeadless(maxTicks, maxSeconds));
+        } else {
+            Menu menu;
+            menu.playLogo();
+            menu.show();
+        }
     } catch (const TextureLoadException &e) {
         LOG_ERROR("Error: " << e.what());
         std::exit(EXIT_FAILURE);
@@ -61,4 +185,4 @@ int main(int argc, char *argv[]) {
         std::exit(EXIT_FAILURE);
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}